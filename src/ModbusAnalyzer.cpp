@@ -1,14 +1,13 @@
 #include "ModbusAnalyzer.h"
 #include "ModbusAnalyzerSettings.h"
+#include "ModbusCrc.h"
+#include "ModbusPduLayouts.h"
 #include <AnalyzerChannelData.h>
 
 
 ModbusAnalyzer::ModbusAnalyzer() : Analyzer2(), mSettings( new ModbusAnalyzerSettings() ), mSimulationInitilized( false )
 {
     SetAnalyzerSettings( mSettings.get() );
-
-    // used for calculating Modbus Checksum values
-    init_crc16_tab();
 }
 
 ModbusAnalyzer::~ModbusAnalyzer()
@@ -43,6 +42,27 @@ void ModbusAnalyzer::ComputeSampleOffsets()
     // 1/2 bit after the beginning of the stop bit
     mStartOfStopBitOffset = clock_generator.AdvanceByHalfPeriod(
         1.0 ); // i.e. moving from the center of the last data bit (where we left off) to 1/2 period into the stop bit
+    mEndOfStopBitOffset = clock_generator.AdvanceByHalfPeriod( 0.5 );
+
+    // RTU frames are delimited by silence: a gap of more than 1.5 character times ends an ADU early, and ADUs are separated by at least
+    // 3.5 character times. Above 19200 baud the spec fixes these at 750us and 1.75ms.
+    U32 bits_per_character = 1 + mSettings->mBitsPerTransfer + 1;
+    if( mSettings->mParity != ModbusAnalyzerEnums::NoneOne )
+        bits_per_character++; // parity bit, or the 2nd stop bit
+
+    double character_time_s = double( bits_per_character ) / double( mSettings->mBitRate );
+    double t1_5 = 1.5 * character_time_s;
+    double t3_5 = 3.5 * character_time_s;
+    if( mSettings->mBitRate > 19200 )
+    {
+        t1_5 = 0.00075;
+        t3_5 = 0.00175;
+    }
+
+    // silence is measured from the (last) stop bit sample point, which is half a bit before the end of the character
+    double half_bit_s = 0.5 / double( mSettings->mBitRate );
+    mInterCharacterTimeout = U64( ( t1_5 + half_bit_s ) * double( mSampleRateHz ) );
+    mInterFrameDelay = U64( ( t3_5 + half_bit_s ) * double( mSampleRateHz ) );
 }
 
 
@@ -55,6 +75,8 @@ void ModbusAnalyzer::SetupResults()
     mResults.reset( new ModbusAnalyzerResults( this, mSettings.get() ) );
     SetAnalyzerResults( mResults.get() );
     mResults->AddChannelBubblesWillAppearOn( mSettings->mInputChannel );
+    if( mSettings->IsFullDuplex() )
+        mResults->AddChannelBubblesWillAppearOn( mSettings->mResponseChannel );
 }
 
 void ModbusAnalyzer::WorkerThread()
@@ -78,24 +100,34 @@ void ModbusAnalyzer::WorkerThread()
         mBitLow = BIT_HIGH;
     }
 
-    U64 bit_mask = 0;
-    U64 mask = 0x1ULL;
-    for( U32 i = 0; i < num_bits; i++ )
+    // requests (or everything) come in on the input channel; in full duplex modes responses have a channel of their own
+    mLineCount = mSettings->IsFullDuplex() ? 2 : 1;
+    mLines[ 0 ].mChannel = mSettings->mInputChannel;
+    mLines[ 0 ].mFrameType = FRAME_TYPE_REQUEST_LINE;
+    mLines[ 1 ].mChannel = mSettings->mResponseChannel;
+    mLines[ 1 ].mFrameType = FRAME_TYPE_RESPONSE_LINE;
+
+    for( U32 i = 0; i < mLineCount; i++ )
     {
-        bit_mask |= mask;
-        mask <<= 1;
-    }
+        mLines[ i ].mData = GetAnalyzerChannelData( mLines[ i ].mChannel );
+        mLines[ i ].mData->TrackMinimumPulseWidth();
+        mLines[ i ].mRtuLineActive = false;
+        mLines[ i ].mLastFrameEndingSample = 0;
 
-    mModbus = GetAnalyzerChannelData( mSettings->mInputChannel );
-    mModbus->TrackMinimumPulseWidth();
+        if( mLines[ i ].mData->GetBitState() == mBitLow )
+            mLines[ i ].mData->AdvanceToNextEdge();
+    }
 
-    if( mModbus->GetBitState() == mBitLow )
-        mModbus->AdvanceToNextEdge();
+    SelectLine( mLines[ 0 ] );
 
     // if Modbus isn't selected, use the other code untouched
     if( mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusRTUClient && mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusRTUServer &&
         mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusASCIIClient &&
-        mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusASCIIServer )
+        mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusASCIIServer &&
+        mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusRTUHalfDuplex &&
+        mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusASCIIHalfDuplex &&
+        mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusRTUFullDuplex &&
+        mSettings->mModbusMode != ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
     {
         AnalyzerHelpers::Assert( "The Modbus analyzer can't be used in a non-modbus mode." );
         ////todo: delete all this code.
@@ -251,2195 +283,117 @@ void ModbusAnalyzer::WorkerThread()
     else if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient ||
              mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
              mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
-             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer )
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
     {
+        bool server_mode = mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
+                           mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer;
+        bool half_duplex = mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+                           mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex;
+
+        SelectCharacterDecoder( num_bits );
+        SelectPduLayouts();
+
+        mLastFrameEndingSample = 0;
+        mAwaitingResponse = false;
+        mTransactionCount = 0;
+        mUncommittedFrames = 0;
+        mLastCommitTime = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock( mStatsMutex );
+            mTrafficStats.Reset( mSampleRateHz, mLineCount );
+            mPollingCycles.Reset();
+        }
+
         for( ;; )
         {
             Frame frame;
             U64 starting_frame;
             U64 ending_frame;
-            U64 Payload1[ 2 ];
-            U64 Payload2[ 2 ];
-            U64 Payload3[ 2 ];
-            U64 Payload4[ 2 ];
-            U64 RecChecksum[ 2 ];
-            U64 ByteCount[ 2 ];
-            U64 Checksum;
-
-            // if analyzer is in ASCII mode, we need to make sure we catch the ':' byte as the start of frame, RTU just uses silence
-            if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
-                mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer )
-            {
-                char rawdata = 0x00;
-                do
-                {
-                    rawdata = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    frame.mStartingSampleInclusive = starting_frame;
-                } while( rawdata != ':' );
-            }
+
+            // Collect the whole ADU first (ASCII frames run from ':' to CR LF, RTU ones are delimited by silence); everything below
+            // works from that buffer.
+            SelectLine( NextLine() );
+            if( !ReadAdu() )
+                continue;
 
             // the frame begins here with the Device Address
 
-            U64 devaddr = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
+            U64 devaddr = GetAduByte( starting_frame, ending_frame );
             frame.mStartingSampleInclusive = starting_frame;
 
             // Then comes the Function Code
-            U64 funccode = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-            // Now we'll process the rest of the data based on whether the transmission is coming from the client or a server device
-            if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient ||
-                mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient )
-            {
-                frame.mFlags = FLAG_REQUEST_FRAME;
-
-                // It's a client device doing the talking
-                switch( funccode )
-                {
-                    // use fall through to process similar requests with the same code
-                case FUNCCODE_READ_COILS:
-                case FUNCCODE_READ_DISCRETE_INPUTS:
-                case FUNCCODE_READ_HOLDING_REGISTERS:
-                case FUNCCODE_READ_INPUT_REGISTER:
-                case FUNCCODE_WRITE_SINGLE_COIL:
-                case FUNCCODE_WRITE_SINGLE_REGISTER:
-                case FUNCCODE_DIAGNOSTIC:
-
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-                        Checksum = Checksum + Payload1[ 1 ];
-                        Checksum = Checksum + Payload2[ 0 ];
-                        Checksum = Checksum + Payload2[ 1 ];
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-
-                    // this set of cases have requests which are just 1 byte long (function code only)
-                case FUNCCODE_READ_EXCEPTION_STATUS:
-                case FUNCCODE_GET_COM_EVENT_COUNTER:
-                case FUNCCODE_GET_COM_EVENT_LOG:
-                case FUNCCODE_REPORT_SERVER_ID:
-
-                    Payload1[ 0 ] = 0x00;
-                    Payload1[ 1 ] = 0x00;
-
-                    Payload2[ 0 ] = 0x00;
-                    Payload2[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                       ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_COILS:
-
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    ByteCount[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                        Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ]; i++ )
-                        {
-                            DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload1[ 1 ] = 0x00;
-
-                            DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        // end this frame here and make frames for each of the output values
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-                        Checksum = Checksum + Payload1[ 1 ];
-                        Checksum = Checksum + Payload2[ 0 ];
-                        Checksum = Checksum + Payload2[ 1 ];
-                        Checksum = Checksum + ByteCount[ 0 ];
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ]; i++ )
-                        {
-                            DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload1[ 1 ] = 0x00;
-
-                            DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            Checksum = Checksum + Payload1[ 0 ];
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    ByteCount[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                        Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ] / 2; i++ )
-                        {
-                            DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        // end this frame here and make frames for each of the output values
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-                        Checksum = Checksum + Payload1[ 1 ];
-                        Checksum = Checksum + Payload2[ 0 ];
-                        Checksum = Checksum + Payload2[ 1 ];
-                        Checksum = Checksum + ByteCount[ 0 ];
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ] / 2; i++ )
-                        {
-                            DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload1[ 1 ];
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-                case FUNCCODE_READ_FILE_RECORD:
-
-                    Payload1[ 0 ] = 0x00;
-                    Payload1[ 1 ] = 0x00;
-
-                    Payload2[ 0 ] = 0x00;
-                    Payload2[ 1 ] = 0x00;
-
-                    ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    ByteCount[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                       ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ( ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ] ); i = i + 7 )
-                        {
-                            DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                            // Reference Type
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = 0x00;
-
-                            // File number
-                            Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Number
-                            Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Length
-                            Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                               ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                               ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload4[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload4[ 1 ] );
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        // end this frame here and make frames for each of the output values
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + ByteCount[ 0 ];
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ( ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ] ); i = i + 7 )
-                        {
-                            DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                            // Reference Type
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = 0x00;
-
-                            // File number
-                            Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Number
-                            Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Length
-                            Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                               ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                               ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload2[ 0 ];
-                            Checksum = Checksum + Payload2[ 1 ];
-                            Checksum = Checksum + Payload3[ 0 ];
-                            Checksum = Checksum + Payload3[ 1 ];
-                            Checksum = Checksum + Payload4[ 0 ];
-                            Checksum = Checksum + Payload4[ 1 ];
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-                case FUNCCODE_WRITE_FILE_RECORD:
-                    Payload1[ 0 ] = 0x00;
-                    Payload1[ 1 ] = 0x00;
-
-                    Payload2[ 0 ] = 0x00;
-                    Payload2[ 1 ] = 0x00;
-
-                    ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    ByteCount[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                       ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ]; i = i + 9 )
-                        {
-                            DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                            // Reference Type
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = 0x00;
-
-                            // File number
-                            Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Number
-                            Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Length
-                            Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                               ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                               ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload4[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload4[ 1 ] );
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-
-                            Frame RecDataFrame;
-                            int k;
-                            for( k = 0; k < ( ( Payload4[ 1 ] << 8 ) + Payload4[ 0 ] ); k++ )
-                            {
-                                RecDataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                RecDataFrame.mStartingSampleInclusive = starting_frame;
-                                Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                RecDataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                RecDataFrame.mEndingSampleInclusive = ending_frame;
-
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                                mResults->AddFrame( RecDataFrame );
-                                mResults->CommitResults();
-                            }
-                            i = i + ( k * 2 );
-                        }
-
-                        // end this frame here and make frames for each of the output values
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + ByteCount[ 0 ];
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ]; i = i + 9 )
-                        {
-                            DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                            // Reference Type
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = 0x00;
-
-                            // File number
-                            Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Number
-                            Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            // Record Length
-                            Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                               ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                               ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload2[ 0 ];
-                            Checksum = Checksum + Payload2[ 1 ];
-                            Checksum = Checksum + Payload3[ 0 ];
-                            Checksum = Checksum + Payload3[ 1 ];
-                            Checksum = Checksum + Payload4[ 0 ];
-                            Checksum = Checksum + Payload4[ 1 ];
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-
-                            Frame RecDataFrame;
-                            int k;
-                            for( k = 0; k < ( ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ] ); k++ )
-                            {
-                                RecDataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                RecDataFrame.mStartingSampleInclusive = starting_frame;
-                                Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                RecDataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                RecDataFrame.mEndingSampleInclusive = ending_frame;
-
-                                Checksum = Checksum + Payload1[ 0 ];
-                                Checksum = Checksum + Payload1[ 1 ];
-
-                                mResults->AddFrame( RecDataFrame );
-                                mResults->CommitResults();
-                            }
-                            i = i + ( k * 2 );
-                        }
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-                case FUNCCODE_MASK_WRITE_REGISTER:
-
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        frame.mData2 = ( Payload3[ 0 ] << 8 ) + Payload3[ 1 ];
-                    }
-                    else
-                    {
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-                        Checksum = Checksum + Payload1[ 1 ];
-                        Checksum = Checksum + Payload2[ 0 ];
-                        Checksum = Checksum + Payload2[ 1 ];
-                        Checksum = Checksum + Payload3[ 0 ];
-                        Checksum = Checksum + Payload3[ 1 ];
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        frame.mData2 = ( Payload3[ 0 ] << 8 ) + Payload3[ 1 ];
-                    }
-                    break;
-                case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                    // code this section and client is done.. wooo
-
-                    // Read Starting Address
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    // Quantity to read
-                    Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    // Write Starting Address
-                    Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    // Quantity to write
-                    Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    // Write Byte Count
-                    ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    ByteCount[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mData2 = ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) + ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-                        Checksum = update_CRC( Checksum, Payload4[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload4[ 1 ] );
-                        Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ] / 2; i++ )
-                        {
-                            DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        // end this frame here and make frames for each of the output values
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                        frame.mData2 = ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) + ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                        frame.mEndingSampleInclusive = ending_frame;
-                        mResults->AddFrame( frame );
-                        mResults->CommitResults();
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-                        Checksum = Checksum + Payload1[ 1 ];
-                        Checksum = Checksum + Payload2[ 0 ];
-                        Checksum = Checksum + Payload2[ 1 ];
-                        Checksum = Checksum + Payload3[ 0 ];
-                        Checksum = Checksum + Payload3[ 1 ];
-                        Checksum = Checksum + Payload4[ 0 ];
-                        Checksum = Checksum + Payload4[ 1 ];
-                        Checksum = Checksum + ByteCount[ 0 ];
-
-                        Frame DataFrame;
-
-                        for( int i = 0; i < ByteCount[ 0 ] / 2; i++ )
-                        {
-                            DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                            Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mStartingSampleInclusive = starting_frame;
-
-                            Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            DataFrame.mEndingSampleInclusive = ending_frame;
-
-                            DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload1[ 1 ];
-
-                            mResults->AddFrame( DataFrame );
-                            mResults->CommitResults();
-                        }
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        frame.mFlags = FLAG_END_FRAME;
-                        frame.mStartingSampleInclusive = starting_frame;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-
-                case FUNCCODE_READ_FIFO_QUEUE:
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                    Payload2[ 0 ] = 0x00;
-                    Payload2[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
-                    {
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                        Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-                        Checksum = Checksum + Payload1[ 1 ];
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    break;
-
-                default:
-                    break;
-                }
-            }
+            U64 funccode = GetAduByte( starting_frame, ending_frame );
+
+            // A client device does the talking in client mode; in server mode it's either a normal response or a Nak/Error. With both
+            // on one line, each ADU has to be told apart by its shape; with a line each, it's whichever line the ADU came in on.
+            bool response;
+            if( mLineCount > 1 )
+                response = mLine->mFrameType == FRAME_TYPE_RESPONSE_LINE;
+            else if( half_duplex )
+                response = AduIsResponse( devaddr, funccode );
             else
-            {
-                // server mode
-                // check if it's a normal response or a Nak/Error
-                if( funccode & 0x80 )
-                {
-                    // it's a NAK/Error
-                    frame.mFlags = FLAG_EXCEPTION_FRAME;
-
-                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                    Payload1[ 1 ] = 0x00;
-
-                    Payload2[ 0 ] = 0x00;
-                    Payload2[ 1 ] = 0x00;
-
-                    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                    {
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                        Checksum = update_CRC( Checksum, devaddr );
-                        Checksum = update_CRC( Checksum, funccode );
-                        Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                        if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                       ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                    else
-                    {
-                        RecChecksum[ 1 ] = 0x00;
-                        RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                        Checksum = Checksum + devaddr;
-                        Checksum = Checksum + funccode;
-                        Checksum = Checksum + Payload1[ 0 ];
-
-                        Checksum = ~Checksum + 1;
-                        Checksum = Checksum & 0x00FF;
-
-                        if( Checksum != RecChecksum[ 0 ] )
-                        {
-                            frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                        }
-
-                        frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                       ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                    }
-                }
-                else
-                {
-                    // it's a valid response
-                    frame.mFlags = FLAG_RESPONSE_FRAME;
-
-                    // It's a client device doing the talking
-                    switch( funccode )
-                    {
-                        // use fall through to process similar requests with the same code
-                    case FUNCCODE_READ_COILS:
-                    case FUNCCODE_READ_DISCRETE_INPUTS:
-
-                        Payload1[ 0 ] = 0x00;
-                        Payload1[ 1 ] = 0x00;
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                                Checksum = Checksum + Payload1[ 0 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_READ_HOLDING_REGISTERS:
-                    case FUNCCODE_READ_INPUT_REGISTER:
-                    case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-
-                        Payload1[ 0 ] = 0x00;
-                        Payload1[ 1 ] = 0x00;
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ] / 2; i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ] / 2; i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                Checksum = Checksum + Payload1[ 0 ];
-                                Checksum = Checksum + Payload1[ 1 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_WRITE_SINGLE_COIL:
-                    case FUNCCODE_WRITE_SINGLE_REGISTER:
-                    case FUNCCODE_DIAGNOSTIC:
-                    case FUNCCODE_GET_COM_EVENT_COUNTER:
-                    case FUNCCODE_WRITE_MULTIPLE_COILS:
-                    case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-
-                        Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload1[ 1 ];
-                            Checksum = Checksum + Payload2[ 0 ];
-                            Checksum = Checksum + Payload2[ 1 ];
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_READ_EXCEPTION_STATUS:
-                        Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload1[ 1 ] = 0x00;
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + Payload1[ 0 ];
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-                    case FUNCCODE_REPORT_SERVER_ID:
-
-                        Payload1[ 0 ] = 0x00;
-                        Payload1[ 1 ] = 0x00;
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
+                response = server_mode;
 
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
+            frame.mType = mLine->mFrameType;
 
-                            Frame DataFrame;
+            // a response to the outstanding request is paired up with it
+            bool answers_request = response && AduAnswersRequest( devaddr, funccode );
 
-                            for( int i = 0; i < ByteCount[ 0 ]; i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                                Checksum = Checksum + Payload1[ 0 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_GET_COM_EVENT_LOG:
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = 0x00;
-
-                        Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mData2 = ( Payload3[ 1 ] << 24 ) + ( Payload3[ 0 ] << 16 ) + ( Payload4[ 1 ] << 8 ) + Payload4[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload4[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload4[ 1 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ( ByteCount[ 0 ] - 6 ); i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mData2 = ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) + ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload1[ 1 ];
-                            Checksum = Checksum + Payload3[ 0 ];
-                            Checksum = Checksum + Payload3[ 1 ];
-                            Checksum = Checksum + Payload4[ 0 ];
-                            Checksum = Checksum + Payload4[ 1 ];
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ( ByteCount[ 0 ] - 6 ); i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 );
-                                Checksum = Checksum + Payload1[ 0 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_READ_FILE_RECORD:
-                        Payload1[ 0 ] = 0x00;
-                        Payload1[ 1 ] = 0x00;
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i = i + 4 )
-                            {
-                                DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                                // Record Length
-                                Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-                                Payload4[ 1 ] = 0x00;
-
-                                // Reference Type
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload1[ 1 ] = 0x00;
-
-                                // File number
-                                Payload2[ 0 ] = 0x00;
-                                Payload2[ 1 ] = 0x00;
-
-                                // Record Number
-                                Payload3[ 0 ] = 0x00;
-                                Payload3[ 1 ] = 0x00;
-
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 1 ] << 40 ) +
-                                                   ( Payload2[ 0 ] << 32 ) + ( Payload3[ 1 ] << 24 ) + ( Payload3[ 0 ] << 16 ) +
-                                                   ( Payload4[ 1 ] << 8 ) + Payload4[ 0 ];
-                                Checksum = update_CRC( Checksum, Payload4[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-
-                                Frame RecDataFrame;
-                                int k;
-                                for( k = 0; k < ( Payload4[ 0 ] - 1 ); k = k + 2 )
-                                {
-                                    RecDataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                    RecDataFrame.mStartingSampleInclusive = starting_frame;
-                                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                    RecDataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                    RecDataFrame.mEndingSampleInclusive = ending_frame;
-
-                                    Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                                    Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                                    mResults->AddFrame( RecDataFrame );
-                                    mResults->CommitResults();
-                                }
-                                i = i + k;
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i = i + 2 )
-                            {
-                                DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                                // Record Length
-                                Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-                                Payload4[ 1 ] = 0x00;
-
-                                // Reference Type
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload1[ 1 ] = 0x00;
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                Payload2[ 0 ] = 0x00;
-                                Payload2[ 1 ] = 0x00;
-
-                                Payload3[ 0 ] = 0x00;
-                                Payload3[ 1 ] = 0x00;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                                   ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                                   ( Payload4[ 1 ] << 8 ) + Payload4[ 0 ];
-
-                                Checksum = Checksum + Payload4[ 0 ];
-                                Checksum = Checksum + Payload1[ 0 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-
-                                Frame RecDataFrame;
-                                int k;
-                                for( k = 0; k < ( Payload4[ 0 ] - 1 ); k = k + 2 )
-                                {
-                                    RecDataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                    RecDataFrame.mStartingSampleInclusive = starting_frame;
-                                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                    RecDataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                    RecDataFrame.mEndingSampleInclusive = ending_frame;
-
-                                    Checksum = Checksum + Payload1[ 0 ];
-                                    Checksum = Checksum + Payload1[ 1 ];
-
-                                    mResults->AddFrame( RecDataFrame );
-                                    mResults->CommitResults();
-                                }
-                                i = i + k;
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_WRITE_FILE_RECORD:
-                        Payload1[ 0 ] = 0x00;
-                        Payload1[ 1 ] = 0x00;
-
-                        Payload2[ 0 ] = 0x00;
-                        Payload2[ 1 ] = 0x00;
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i = i + 9 )
-                            {
-                                DataFrame.mFlags = FLAG_FILE_SUBREQ;
+            if( !response )
+                frame.mFlags = FLAG_REQUEST_FRAME;
+            else if( funccode & 0x80 )
+                frame.mFlags = FLAG_EXCEPTION_FRAME;
+            else
+                frame.mFlags = FLAG_RESPONSE_FRAME;
 
-                                // Reference Type
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-
-                                // File number
-                                Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
+            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 );
+            frame.mData2 = 0;
+            if( answers_request )
+                frame.mData2 = TURNAROUND_PAIRED | ( U64( Turnaround() ) << TURNAROUND_SHIFT );
 
-                                // Record Number
-                                Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
+            // the rest of the ADU is laid out according to the function code
+            bool has_body = ParsePdu( response ? *mResponseLayouts[ funccode ] : *mRequestLayouts[ funccode ], frame, ending_frame );
 
-                                // Record Length
-                                Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                                   ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                                   ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                                Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-                                Checksum = update_CRC( Checksum, Payload4[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload4[ 1 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-
-                                Frame RecDataFrame;
-                                int k;
-                                for( k = 0; k < ( ( Payload4[ 1 ] << 8 ) + Payload4[ 0 ] ); k++ )
-                                {
-                                    RecDataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                    RecDataFrame.mStartingSampleInclusive = starting_frame;
-                                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                    RecDataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                    RecDataFrame.mEndingSampleInclusive = ending_frame;
-
-                                    Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                                    Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                                    mResults->AddFrame( RecDataFrame );
-                                    mResults->CommitResults();
-                                }
-                                i = i + ( k * 2 );
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ByteCount[ 0 ]; i = i + 9 )
-                            {
-                                DataFrame.mFlags = FLAG_FILE_SUBREQ;
-
-                                // Reference Type
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = 0x00;
-
-                                // File number
-                                Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                // Record Number
-                                Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                // Record Length
-                                Payload4[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                Payload4[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 1 ] << 56 ) + ( Payload1[ 0 ] << 48 ) + ( Payload2[ 0 ] << 40 ) +
-                                                   ( Payload2[ 1 ] << 32 ) + ( Payload3[ 0 ] << 24 ) + ( Payload3[ 1 ] << 16 ) +
-                                                   ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ];
-
-                                Checksum = Checksum + Payload1[ 0 ];
-                                Checksum = Checksum + Payload2[ 0 ];
-                                Checksum = Checksum + Payload2[ 1 ];
-                                Checksum = Checksum + Payload3[ 0 ];
-                                Checksum = Checksum + Payload3[ 1 ];
-                                Checksum = Checksum + Payload4[ 0 ];
-                                Checksum = Checksum + Payload4[ 1 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-
-                                Frame RecDataFrame;
-                                int k;
-                                for( k = 0; k < ( ( Payload4[ 0 ] << 8 ) + Payload4[ 1 ] ); k++ )
-                                {
-                                    RecDataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                    Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                    RecDataFrame.mStartingSampleInclusive = starting_frame;
-                                    Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                                    RecDataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                    RecDataFrame.mEndingSampleInclusive = ending_frame;
-
-                                    Checksum = Checksum + Payload1[ 0 ];
-                                    Checksum = Checksum + Payload1[ 1 ];
-
-                                    mResults->AddFrame( RecDataFrame );
-                                    mResults->CommitResults();
-                                }
-                                i = i + ( k * 2 );
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    case FUNCCODE_MASK_WRITE_REGISTER:
-
-                        Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload3[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload3[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload3[ 1 ] );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                            frame.mData2 = ( Payload3[ 0 ] << 8 ) + Payload3[ 1 ];
-                        }
-                        else
-                        {
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + Payload1[ 0 ];
-                            Checksum = Checksum + Payload1[ 1 ];
-                            Checksum = Checksum + Payload2[ 0 ];
-                            Checksum = Checksum + Payload2[ 1 ];
-                            Checksum = Checksum + Payload3[ 0 ];
-                            Checksum = Checksum + Payload3[ 1 ];
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                            frame.mData2 = ( Payload3[ 0 ] << 8 ) + Payload3[ 1 ];
-                        }
-                        break;
-
-                    case FUNCCODE_READ_FIFO_QUEUE:
-
-                        ByteCount[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        ByteCount[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload2[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                        Payload2[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                        Payload1[ 0 ] = 0x00;
-                        Payload1[ 1 ] = 0x00;
-
-                        if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 1 ] << 40 ) + ( Payload1[ 0 ] << 32 ) +
-                                           ( Payload2[ 1 ] << 24 ) + ( Payload2[ 0 ] << 16 ) + ( ByteCount[ 1 ] << 8 ) + ByteCount[ 0 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-                            Checksum = update_CRC( Checksum, devaddr );
-                            Checksum = update_CRC( Checksum, funccode );
-                            Checksum = update_CRC( Checksum, ByteCount[ 0 ] );
-                            Checksum = update_CRC( Checksum, ByteCount[ 1 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 0 ] );
-                            Checksum = update_CRC( Checksum, Payload2[ 1 ] );
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ( ( Payload2[ 1 ] << 8 ) + Payload2[ 0 ] ); i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                Checksum = update_CRC( Checksum, Payload1[ 0 ] );
-                                Checksum = update_CRC( Checksum, Payload1[ 1 ] );
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            // end this frame here and make frames for each of the output values
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            RecChecksum[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-
-                            if( ( ( ( Checksum & 0xFF00 ) >> 8 ) != RecChecksum[ 1 ] ) || ( ( Checksum & 0x00FF ) != RecChecksum[ 0 ] ) )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // error!
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        else
-                        {
-                            frame.mData1 = ( devaddr << 56 ) + ( funccode << 48 ) + ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 ) +
-                                           ( Payload2[ 0 ] << 24 ) + ( Payload2[ 1 ] << 16 ) + ( ByteCount[ 0 ] << 8 ) + ByteCount[ 1 ];
-                            frame.mEndingSampleInclusive = ending_frame;
-                            mResults->AddFrame( frame );
-                            mResults->CommitResults();
-
-                            Checksum = 0x0000; // Modbus/ASCII uses LRC, initialization to 0x0000;
-
-                            Checksum = Checksum + devaddr;
-                            Checksum = Checksum + funccode;
-                            Checksum = Checksum + ByteCount[ 0 ];
-                            Checksum = Checksum + ByteCount[ 1 ];
-                            Checksum = Checksum + Payload2[ 0 ];
-                            Checksum = Checksum + Payload2[ 1 ];
-
-                            Frame DataFrame;
-
-                            for( int i = 0; i < ( ( Payload2[ 0 ] << 8 ) + Payload2[ 1 ] ); i++ )
-                            {
-                                DataFrame.mFlags = FLAG_DATA_FRAME;
-
-                                Payload1[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mStartingSampleInclusive = starting_frame;
-
-                                Payload1[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                                DataFrame.mEndingSampleInclusive = ending_frame;
-
-                                DataFrame.mData1 = ( Payload1[ 0 ] << 40 ) + ( Payload1[ 1 ] << 32 );
-                                Checksum = Checksum + Payload1[ 0 ];
-                                Checksum = Checksum + Payload1[ 1 ];
-
-                                mResults->AddFrame( DataFrame );
-                                mResults->CommitResults();
-                            }
-
-                            Checksum = ~Checksum + 1;
-                            Checksum = Checksum & 0x00FF;
-
-                            RecChecksum[ 1 ] = 0x00;
-                            RecChecksum[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                            frame.mFlags = FLAG_END_FRAME;
-                            frame.mStartingSampleInclusive = starting_frame;
-
-                            if( Checksum != RecChecksum[ 0 ] )
-                            {
-                                frame.mFlags = frame.mFlags | FLAG_CHECKSUM_ERROR; // Error with LRC error
-                            }
-
-                            frame.mData1 = ( RecChecksum[ 1 ] << 8 ) + RecChecksum[ 0 ];
-                        }
-                        break;
-
-                    default:
-                        // nothing for now
-                        break;
-                    }
-                }
-            }
+            // the frame ends here
+            frame.mEndingSampleInclusive = ending_frame;
 
-            // in ASCII mode, the frame ends with a \n \r termination, in RTU mode, just silence
-            if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
-                mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer )
+            // the ADU ended before the parser was done with it
+            if( mAduTruncated )
+                frame.mFlags |= FLAG_TRUNCATED_FRAME | FLAG_CHECKSUM_ERROR;
+
+            // the ADU didn't follow t3.5 of silence
+            if( mAduMissedSilence )
+                frame.mFlags |= FRAMING_ERROR_FLAG;
+
+            KeepClearOfPreviousFrame( frame );
+            mLine->mLastFrameEndingSample = frame.mEndingSampleInclusive;
+            if( frame.mEndingSampleInclusive > S64( mLastFrameEndingSample ) )
+                mLastFrameEndingSample = frame.mEndingSampleInclusive;
+            U64 frame_index = mResults->AddFrame( frame );
+            if( has_body )
+                mResults->AddPayload( frame_index, mAdu.mBytes, mAdu.mLength );
+            mResults->IndexFrame( frame_index, frame, mAduParityErrors != 0 || mAduFramingErrors != 0 || mAduMissedSilence );
+
+            // one packet per ADU
+            U64 packet_id = mResults->CommitPacketAndStartNewPacket();
+            TrackTransaction( response, answers_request, devaddr, funccode, packet_id, frame.mEndingSampleInclusive );
+
+            U8 exception_code = mAdu.mLength > 2 ? mAdu.mBytes[ 2 ] : 0;
+            bool checksum_error = ( frame.mFlags & FLAG_CHECKSUM_ERROR ) != 0;
             {
-                char StopFrame[ 2 ];
-                StopFrame[ 0 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-                StopFrame[ 1 ] = GetNextByteModbus( num_bits, bit_mask, starting_frame, ending_frame );
-            }
+                std::lock_guard<std::mutex> lock( mStatsMutex );
+                mTrafficStats.AddAdu( devaddr, funccode, response, mAdu.mLength, exception_code, checksum_error, mAduParityErrors,
+                                      mAduFramingErrors, mAdu.mStartingSamples[ 0 ], mAdu.mEndingSamples[ mAdu.mLength - 1 ] );
 
-            // the frame ends here
-            frame.mEndingSampleInclusive = ending_frame;
-            mResults->AddFrame( frame );
-            mResults->CommitResults();
+                if( !response && !checksum_error )
+                    TrackPolling( devaddr, funccode );
+            }
 
-            ReportProgress( frame.mEndingSampleInclusive );
-            CheckIfThreadShouldExit();
+            CommitIfDue( frame.mEndingSampleInclusive );
         }
     }
 }
@@ -2507,6 +461,13 @@ const char* ModbusAnalyzer::GetAnalyzerName() const
     return "Modbus";
 }
 
+void ModbusAnalyzer::GetStatistics( ModbusTrafficStats& traffic_stats, ModbusPollingCycles& polling_cycles ) const
+{
+    std::lock_guard<std::mutex> lock( mStatsMutex );
+    traffic_stats = mTrafficStats;
+    polling_cycles = mPollingCycles;
+}
+
 const char* GetAnalyzerName()
 {
     return "Modbus";
@@ -2522,282 +483,650 @@ void DestroyAnalyzer( Analyzer* analyzer )
     delete analyzer;
 }
 
-U64 ModbusAnalyzer::GetNextByteModbus( U32 num_bits, U64 bit_mask, U64& frame_starting_sample, U64& frame_ending_sample )
+bool ModbusAnalyzer::ReadAdu()
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    mAdu.mLength = 0;
+    mAduIndex = 0;
+    mAduTruncated = false;
+    mAduParityErrors = 0;
+    mAduFramingErrors = 0;
+    mAduMissedSilence = false;
+
+    if( !mAsciiMode )
     {
-        mModbus->AdvanceToNextEdge();
+        ReadRtuAdu();
+        return true;
+    }
 
-        // we're now at the beginning of the start bit.  We can start collecting the data.
-        frame_starting_sample = mModbus->GetSampleNumber();
+    return ReadAsciiAdu();
+}
 
-        U64 data = 0;
-        bool parity_error = false;
-        bool framing_error = false;
-        bool mp_is_address = false;
+void ModbusAnalyzer::ReadRtuAdu()
+{
+    U64 starting_sample;
+    U64 ending_sample;
 
-        DataBuilder data_builder;
-        data_builder.Reset( &data, mSettings->mShiftOrder, num_bits );
-        U64 marker_location = frame_starting_sample;
+    // We don't know how long the line was idle before the capture started, so the first character always counts as the start of an
+    // ADU. After that, an ADU should only start after t3.5 of silence. One that follows a shorter gap (longer than t1.5, or it would
+    // have been part of the last ADU) is still decoded, so no characters go missing, but it gets flagged as a framing error.
+    mAduMissedSilence = mLine->mRtuLineActive && mModbus->GetSampleOfNextEdge() - mModbus->GetSampleNumber() < mInterFrameDelay;
+    mLine->mRtuLineActive = true;
 
-        for( U32 i = 0; i < num_bits; i++ )
-        {
-            mModbus->Advance( mSampleOffsets[ i ] );
-            data_builder.AddBit( mModbus->GetBitState() );
+    U64 data = ( this->*mDecodeCharacter )( starting_sample, ending_sample );
+    AppendAduByte( data, starting_sample, ending_sample );
 
-            marker_location += mSampleOffsets[ i ];
-            mResults->AddMarker( marker_location, AnalyzerResults::Dot, mSettings->mInputChannel );
-        }
+    // the ADU runs until the line has been quiet for more than t1.5
+    while( mModbus->WouldAdvancingToAbsPositionCauseTransition( mModbus->GetSampleNumber() + mInterCharacterTimeout ) )
+    {
+        data = ( this->*mDecodeCharacter )( starting_sample, ending_sample );
+        AppendAduByte( data, starting_sample, ending_sample );
+    }
+}
 
-        if( mSettings->mInverted == true )
-            data = ( ~data ) & bit_mask;
+bool ModbusAnalyzer::ReadAsciiAdu()
+{
+    U64 starting_sample;
+    U64 ending_sample;
+    U64 character;
+
+    // A frame starts with ':'. Anything else (the LF of the last CR LF, noise) is dropped one character per call, so that in full duplex
+    // the other line gets its turn in between.
+    character = ( this->*mDecodeCharacter )( starting_sample, ending_sample );
+    if( character != ':' )
+        return false;
 
-        parity_error = false;
+    // then two hex characters per byte, until the CR LF termination
+    U64 byte_starting_sample = 0;
+    bool have_high_nibble = false;
+    U8 value = 0;
 
-        if( mSettings->mParity != ModbusAnalyzerEnums::NoneOne && mSettings->mParity != ModbusAnalyzerEnums::NoneTwo )
+    for( ;; )
+    {
+        character = ( this->*mDecodeCharacter )( starting_sample, ending_sample );
+
+        if( character == ':' )
         {
-            mModbus->Advance( mParityBitOffset );
-            bool is_even = AnalyzerHelpers::IsEven( AnalyzerHelpers::GetOnesCount( data ) );
+            // a new frame started before this one was terminated; drop what we have and start over
+            mAdu.mLength = 0;
+            have_high_nibble = false;
+            continue;
+        }
 
-            if( mSettings->mParity == ModbusAnalyzerEnums::EvenOne )
-            {
-                if( is_even == true )
-                {
-                    if( mModbus->GetBitState() != mBitLow ) // we expect a low bit, to keep the parity even.
-                        parity_error = true;
-                }
-                else
-                {
-                    if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, to force parity even.
-                        parity_error = true;
-                }
-            }
-            else // if( mSettings->mParity == ModbusAnalyzerEnums::OddOne )
-            {
-                if( is_even == false )
-                {
-                    if( mModbus->GetBitState() != mBitLow ) // we expect a low bit, to keep the parity odd.
-                        parity_error = true;
-                }
-                else
-                {
-                    if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, to force parity odd.
-                        parity_error = true;
-                }
-            }
+        // the frame is over; if there was nothing between the ':' and the terminator, there is nothing to decode
+        if( character == '\r' || character == '\n' )
+            return mAdu.mLength > 0;
 
-            marker_location += mParityBitOffset;
-            if( !parity_error )
-                mResults->AddMarker( marker_location, AnalyzerResults::Square, mSettings->mInputChannel );
-            else
-                mResults->AddMarker( marker_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-        }
-        else if( mSettings->mParity == ModbusAnalyzerEnums::NoneTwo )
+        if( !have_high_nibble )
         {
-            // no parity, 2 stop bits. lets test the first one here.
-            mModbus->Advance( mStartOfStopBitOffset );
-            if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, for the stop bit
-            {
-                mResults->AddMarker( mModbus->GetSampleNumber(), AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-                framing_error = true;
-            }
+            value = ASCII2INT( character ) << 4;
+            byte_starting_sample = starting_sample;
+            have_high_nibble = true;
         }
-
-        // testing the (next) stop bit too.
-        mModbus->Advance( mStartOfStopBitOffset );
-        if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, for the stop bit
+        else
         {
-            mResults->AddMarker( mModbus->GetSampleNumber(), AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-            framing_error = true;
+            value = value + ASCII2INT( character );
+            AppendAduByte( value, byte_starting_sample, ending_sample );
+            have_high_nibble = false;
         }
+    }
+}
 
-        frame_ending_sample = mModbus->GetSampleNumber();
+void ModbusAnalyzer::AppendAduByte( U8 value, U64 starting_sample, U64 ending_sample )
+{
+    // anything past the largest legal ADU is dropped; the parser never gets that far
+    if( mAdu.mLength >= MODBUS_MAX_ADU_SIZE )
+        return;
+
+    mAdu.mBytes[ mAdu.mLength ] = value;
+    mAdu.mStartingSamples[ mAdu.mLength ] = starting_sample;
+    mAdu.mEndingSamples[ mAdu.mLength ] = ending_sample;
+    mAdu.mLength++;
+}
 
-        return data;
+U64 ModbusAnalyzer::GetAduByte( U64& frame_starting_sample, U64& frame_ending_sample )
+{
+    // Running past the end of the buffer means the ADU was cut short. Hand back zeros for whatever the parser still expects.
+    if( mAduIndex >= mAdu.mLength )
+    {
+        mAduTruncated = true;
+        return 0;
+    }
+
+    frame_starting_sample = mAdu.mStartingSamples[ mAduIndex ];
+    frame_ending_sample = mAdu.mEndingSamples[ mAduIndex ];
+    return mAdu.mBytes[ mAduIndex++ ];
+}
+
+bool ModbusAnalyzer::AduChecksumMatches()
+{
+    // the checksum covers everything the parser consumed before the checksum itself
+    if( mAduTruncated )
+        return false;
+
+    if( !mAsciiMode )
+    {
+        if( mAduIndex < 2 )
+            return false;
+
+        U32 length = mAduIndex - 2;
+        U16 crc = crc16_modbus( mAdu.mBytes, length ); // Modbus/RTU uses CRC-16
+
+        return mAdu.mBytes[ length ] == ( crc & 0x00FF ) && mAdu.mBytes[ length + 1 ] == ( crc >> 8 );
     }
     else
     {
-        U8 value = 0;
-        // first get MSByte of ASCII data
-        mModbus->AdvanceToNextEdge();
+        if( mAduIndex < 1 )
+            return false;
 
-        // we're now at the beginning of the start bit.  We can start collecting the data.
-        frame_starting_sample = mModbus->GetSampleNumber();
+        U32 length = mAduIndex - 1;
+        U8 lrc = 0x00; // Modbus/ASCII uses LRC, initialization to 0x00
+        for( U32 i = 0; i < length; i++ )
+            lrc += mAdu.mBytes[ i ];
 
-        U64 data = 0;
-        bool parity_error = false;
-        bool framing_error = false;
-        bool mp_is_address = false;
+        lrc = -lrc;
+        return mAdu.mBytes[ length ] == lrc;
+    }
+}
 
-        DataBuilder data_builder;
-        data_builder.Reset( &data, mSettings->mShiftOrder, num_bits );
-        U64 marker_location = frame_starting_sample;
+void ModbusAnalyzer::SelectCharacterDecoder( U32 num_bits )
+{
+    // one instantiation per line configuration, indexed by parity/stop bits, inversion, shift order and 7/8 data bits (in that order)
+    static const CharacterDecoder decoders[] = {
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, false, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, false, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, false, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, false, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, true, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, true, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, true, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneTwo, true, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, false, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, false, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, false, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, false, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, true, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, true, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, true, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::EvenOne, true, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, false, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, false, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, false, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, false, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, true, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, true, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, true, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::OddOne, true, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, false, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, false, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, false, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, false, AnalyzerEnums::LsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, true, AnalyzerEnums::MsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, true, AnalyzerEnums::MsbFirst, 8>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, true, AnalyzerEnums::LsbFirst, 7>,
+        &ModbusAnalyzer::DecodeCharacter<ModbusAnalyzerEnums::NoneOne, true, AnalyzerEnums::LsbFirst, 8>,
+    };
+
+    if( num_bits != 7 && num_bits != 8 )
+        AnalyzerHelpers::Assert( "The Modbus analyzer only supports 7 or 8 data bits." );
+
+    U32 index = U32( mSettings->mParity ) * 8;
+    if( mSettings->mInverted == true )
+        index += 4;
+    if( mSettings->mShiftOrder == AnalyzerEnums::LsbFirst )
+        index += 2;
+    if( num_bits == 8 )
+        index += 1;
+
+    mDecodeCharacter = decoders[ index ];
+
+    // distance from the start bit edge to where the (last) stop bit gets sampled
+    mCharacterSpan = 0;
+    for( U32 i = 0; i < num_bits; i++ )
+        mCharacterSpan += mSampleOffsets[ i ];
 
-        for( U32 i = 0; i < num_bits; i++ )
-        {
-            mModbus->Advance( mSampleOffsets[ i ] );
-            data_builder.AddBit( mModbus->GetBitState() );
+    if( mSettings->mParity == ModbusAnalyzerEnums::EvenOne || mSettings->mParity == ModbusAnalyzerEnums::OddOne )
+        mCharacterSpan += mParityBitOffset;
+    else if( mSettings->mParity == ModbusAnalyzerEnums::NoneTwo )
+        mCharacterSpan += mStartOfStopBitOffset;
 
-            marker_location += mSampleOffsets[ i ];
-            mResults->AddMarker( marker_location, AnalyzerResults::Dot, mSettings->mInputChannel );
-        }
+    mCharacterSpan += mStartOfStopBitOffset;
 
-        if( mSettings->mInverted == true )
-            data = ( ~data ) & bit_mask;
+    mAsciiMode = mSettings->IsAsciiMode();
+    mAddBitMarkers = mSettings->mMarkerDensity == ModbusAnalyzerEnums::MarkersAll;
+    mAddErrorMarkers = mSettings->mMarkerDensity != ModbusAnalyzerEnums::MarkersNone;
 
-        parity_error = false;
+    for( U32 i = 0; i < 256; i++ )
+        mOddParity[ i ] = AnalyzerHelpers::IsOdd( AnalyzerHelpers::GetOnesCount( i ) );
+}
 
-        if( mSettings->mParity != ModbusAnalyzerEnums::NoneOne && mSettings->mParity != ModbusAnalyzerEnums::NoneTwo )
-        {
-            mModbus->Advance( mParityBitOffset );
-            bool is_even = AnalyzerHelpers::IsEven( AnalyzerHelpers::GetOnesCount( data ) );
+template <ModbusAnalyzerEnums::ParityAndStopbits Parity, bool Inverted, AnalyzerEnums::ShiftOrder ShiftOrder, U32 NumBits>
+U64 ModbusAnalyzer::DecodeCharacter( U64& character_starting_sample, U64& character_ending_sample )
+{
+    const BitState bit_high = Inverted ? BIT_LOW : BIT_HIGH;
+    const BitState bit_low = Inverted ? BIT_HIGH : BIT_LOW;
 
-            if( mSettings->mParity == ModbusAnalyzerEnums::EvenOne )
-            {
-                if( is_even == true )
-                {
-                    if( mModbus->GetBitState() != mBitLow ) // we expect a low bit, to keep the parity even.
-                        parity_error = true;
-                }
-                else
-                {
-                    if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, to force parity even.
-                        parity_error = true;
-                }
-            }
-            else // if( mSettings->mParity == ModbusAnalyzerEnums::OddOne )
-            {
-                if( is_even == false )
-                {
-                    if( mModbus->GetBitState() != mBitLow ) // we expect a low bit, to keep the parity odd.
-                        parity_error = true;
-                }
-                else
-                {
-                    if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, to force parity odd.
-                        parity_error = true;
-                }
-            }
+    mModbus->AdvanceToNextEdge();
 
-            marker_location += mParityBitOffset;
-            if( !parity_error )
-                mResults->AddMarker( marker_location, AnalyzerResults::Square, mSettings->mInputChannel );
-            else
-                mResults->AddMarker( marker_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-        }
-        else if( mSettings->mParity == ModbusAnalyzerEnums::NoneTwo )
+    // we're now at the beginning of the start bit.  We can start collecting the data.
+    character_starting_sample = mModbus->GetSampleNumber();
+    BitState bit_state = mModbus->GetBitState();
+
+    // Each sample point is a single AdvanceToAbsPosition(), and the number of transitions it passed on the way gives the level
+    // there, so a character costs one call per bit however many edges it has. The cursor ends up where the (last) stop bit gets
+    // sampled.
+    character_ending_sample = character_starting_sample + mCharacterSpan;
+
+    U64 data = 0;
+    U64 marker_location = character_starting_sample;
+
+    for( U32 i = 0; i < NumBits; i++ )
+    {
+        marker_location += mSampleOffsets[ i ];
+        U64 bit = GetBitStateAt( marker_location, bit_state ) == bit_high ? 1 : 0;
+
+        if( ShiftOrder == AnalyzerEnums::LsbFirst )
+            data |= bit << i;
+        else
+            data = ( data << 1 ) | bit;
+
+        if( mAddBitMarkers )
+            mResults->AddMarker( marker_location, AnalyzerResults::Dot, mLine->mChannel );
+    }
+
+    bool parity_error = false;
+    bool framing_error = false;
+
+    if( Parity == ModbusAnalyzerEnums::EvenOne || Parity == ModbusAnalyzerEnums::OddOne )
+    {
+        marker_location += mParityBitOffset;
+
+        // the parity bit is high when it has to make up the ones count (to even, or to odd)
+        bool expect_high = mOddParity[ data ] != ( Parity == ModbusAnalyzerEnums::OddOne );
+        parity_error = GetBitStateAt( marker_location, bit_state ) != ( expect_high ? bit_high : bit_low );
+
+        if( !parity_error )
         {
-            // there are 2 stop bits, lets check the first one here and the second one later.
-            mModbus->Advance( mStartOfStopBitOffset );
-            if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, for the stop bit
-            {
-                mResults->AddMarker( mModbus->GetSampleNumber(), AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-                framing_error = true;
-            }
+            if( mAddBitMarkers )
+                mResults->AddMarker( marker_location, AnalyzerResults::Square, mLine->mChannel );
         }
-
-        mModbus->Advance( mStartOfStopBitOffset );
-        if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, for the stop bit
+        else if( mAddErrorMarkers )
+            mResults->AddMarker( marker_location, AnalyzerResults::ErrorDot, mLine->mChannel );
+    }
+    else if( Parity == ModbusAnalyzerEnums::NoneTwo )
+    {
+        // no parity, 2 stop bits. lets test the first one here.
+        marker_location += mStartOfStopBitOffset;
+        if( GetBitStateAt( marker_location, bit_state ) != bit_high ) // we expect a high bit, for the stop bit
         {
-            mResults->AddMarker( mModbus->GetSampleNumber(), AnalyzerResults::ErrorDot, mSettings->mInputChannel );
+            if( mAddErrorMarkers )
+                mResults->AddMarker( marker_location, AnalyzerResults::ErrorDot, mLine->mChannel );
             framing_error = true;
         }
+    }
+
+    // testing the (next) stop bit too.
+    marker_location += mStartOfStopBitOffset;
+    if( GetBitStateAt( marker_location, bit_state ) != bit_high ) // we expect a high bit, for the stop bit
+    {
+        if( mAddErrorMarkers )
+            mResults->AddMarker( marker_location, AnalyzerResults::ErrorDot, mLine->mChannel );
+        framing_error = true;
+    }
+
+    if( parity_error )
+        mAduParityErrors++;
+    if( framing_error )
+        mAduFramingErrors++;
+
+    return data;
+}
+
+void ModbusAnalyzer::KeepClearOfPreviousFrame( Frame& frame )
+{
+    // Frames on one line can't overlap; a truncated ADU ends with a frame for bytes that never came, so it starts where the previous
+    // frame on that line ended.
+    if( frame.mStartingSampleInclusive <= S64( mLine->mLastFrameEndingSample ) )
+        frame.mStartingSampleInclusive = mLine->mLastFrameEndingSample + 1;
+    if( frame.mEndingSampleInclusive < frame.mStartingSampleInclusive )
+        frame.mEndingSampleInclusive = frame.mStartingSampleInclusive;
+
+    // In full duplex an ADU may start before the one on the other line is over. Frames still come in the order they start, so it
+    // keeps its real sample range and is only flagged.
+    if( frame.mStartingSampleInclusive <= S64( mLastFrameEndingSample ) )
+        frame.mFlags |= FLAG_OVERLAPPING_FRAME;
+}
+
+void ModbusAnalyzer::CommitIfDue( U64 ending_sample )
+{
+    // Every commit hands the new frames to the GUI, which is costly enough that committing each ADU slows down decoding a capture
+    // that is already complete. So frames go out in batches, but never sit around for long: they are committed as soon as the line
+    // has nothing more to decode yet (a live capture has caught up), and at least every MODBUS_COMMIT_INTERVAL_MS otherwise.
+    mUncommittedFrames++;
+
+    // in full duplex the decoder has only caught up once neither line has anything more
+    bool caught_up = true;
+    for( U32 i = 0; i < mLineCount; i++ )
+        if( mLines[ i ].mData->DoMoreTransitionsExistInCurrentData() )
+            caught_up = false;
+
+    bool due = mUncommittedFrames >= MODBUS_COMMIT_BATCH_FRAMES || caught_up;
+    if( !due )
+        due = std::chrono::steady_clock::now() - mLastCommitTime >= std::chrono::milliseconds( MODBUS_COMMIT_INTERVAL_MS );
+
+    if( !due )
+        return;
+
+    mResults->CommitResults();
+    ReportProgress( ending_sample );
+    CheckIfThreadShouldExit();
+
+    mUncommittedFrames = 0;
+    mLastCommitTime = std::chrono::steady_clock::now();
+}
+
+void ModbusAnalyzer::SelectLine( ModbusLine& line )
+{
+    mLine = &line;
+    mModbus = line.mData;
+}
+
+ModbusLine& ModbusAnalyzer::NextLine()
+{
+    if( mLineCount == 1 )
+        return mLines[ 0 ];
+
+    // Both lines are decoded by this one thread, so whichever has the earlier next edge goes first; that keeps the frames in time
+    // order. Asking a line that has gone quiet for its next edge would wait for the end of the capture, so look ahead one t3.5 window
+    // at a time until either line has something.
+    U64 horizon = mLines[ 0 ].mData->GetSampleNumber();
+    if( mLines[ 1 ].mData->GetSampleNumber() > horizon )
+        horizon = mLines[ 1 ].mData->GetSampleNumber();
+
+    for( ;; )
+    {
+        horizon += mInterFrameDelay;
+
+        bool requests = mLines[ 0 ].mData->WouldAdvancingToAbsPositionCauseTransition( horizon );
+        bool responses = mLines[ 1 ].mData->WouldAdvancingToAbsPositionCauseTransition( horizon );
+
+        if( requests && responses )
+            return mLines[ 0 ].mData->GetSampleOfNextEdge() <= mLines[ 1 ].mData->GetSampleOfNextEdge() ? mLines[ 0 ] : mLines[ 1 ];
+        if( requests )
+            return mLines[ 0 ];
+        if( responses )
+            return mLines[ 1 ];
+
+        CheckIfThreadShouldExit();
+    }
+}
+
+void ModbusAnalyzer::SelectPduLayouts()
+{
+    for( U32 i = 0; i < 256; i++ )
+    {
+        mRequestLayouts[ i ] = &GetModbusPduLayout( i, false );
+        mResponseLayouts[ i ] = &GetModbusPduLayout( i, true );
+    }
+}
+
+bool ModbusAnalyzer::AduIsResponse( U8 devaddr, U8 funccode )
+{
+    bool response;
+
+    // Exceptions only ever come from a server. Otherwise, the direction whose layout accounts for exactly the bytes in the ADU, with the
+    // checksum where that layout puts it, wins. When both or neither do (a write single register is echoed back unchanged, for
+    // instance), fall back on the line alternating: a response answers the last unicast request to the same device and function.
+    if( funccode & 0x80 )
+    {
+        response = true;
+    }
+    else
+    {
+        bool request_fits = AduFitsLayout( *mRequestLayouts[ funccode ] );
+        bool response_fits = AduFitsLayout( *mResponseLayouts[ funccode ] );
 
-        if( data == ':' || data == '\n' || data == '\r' )
-            return data;
+        if( request_fits != response_fits )
+            response = response_fits;
         else
-        {
-            value = ASCII2INT( data ) << 4;
+            response = mAwaitingResponse && devaddr == mLastRequestDevAddr && funccode == mLastRequestFuncCode;
+    }
 
-            // Gets the LSByte of ASCII data
+    return response;
+}
 
-            mModbus->AdvanceToNextEdge();
+bool ModbusAnalyzer::AduAnswersRequest( U8 devaddr, U8 funccode )
+{
+    // same device, same function (or its exception), and laid out the way the response to that function is
+    if( !mAwaitingResponse || devaddr != mLastRequestDevAddr || ( funccode & 0x7F ) != mLastRequestFuncCode )
+        return false;
 
-            // we're now at the beginning of the start bit.  We can start collecting the data.
+    return AduFitsLayout( *mResponseLayouts[ funccode ] );
+}
 
-            data = 0;
-            parity_error = false;
-            framing_error = false;
-            mp_is_address = false;
+U32 ModbusAnalyzer::Turnaround()
+{
+    // from the end of the request to the start of its response; in full duplex a server may start answering early
+    U64 response_start = mAdu.mStartingSamples[ 0 ];
+    if( response_start <= mLastRequestEndingSample )
+        return 0;
 
-            data_builder.Reset( &data, mSettings->mShiftOrder, num_bits );
-            marker_location = mModbus->GetSampleNumber();
+    U64 turnaround = response_start - mLastRequestEndingSample;
+    return turnaround < TURNAROUND_MAX ? U32( turnaround ) : TURNAROUND_MAX;
+}
 
-            for( U32 i = 0; i < num_bits; i++ )
-            {
-                mModbus->Advance( mSampleOffsets[ i ] );
-                data_builder.AddBit( mModbus->GetBitState() );
+void ModbusAnalyzer::TrackTransaction( bool response, bool answers_request, U8 devaddr, U8 funccode, U64 packet_id, U64 ending_sample )
+{
+    if( answers_request )
+    {
+        mResults->AddPacketToTransaction( mTransactionCount, mLastRequestPacket );
+        mResults->AddPacketToTransaction( mTransactionCount, packet_id );
+        mTransactionCount++;
 
-                marker_location += mSampleOffsets[ i ];
-                mResults->AddMarker( marker_location, AnalyzerResults::Dot, mSettings->mInputChannel );
-            }
+        std::lock_guard<std::mutex> lock( mStatsMutex );
+        mTrafficStats.AddResponseTime( devaddr, U64( Turnaround() ) * 1000000 / mSampleRateHz );
+    }
+
+    // there is only ever one request outstanding, and broadcasts (address 0) are never answered
+    mAwaitingResponse = !response && devaddr != 0;
+    if( mAwaitingResponse )
+    {
+        mLastRequestDevAddr = devaddr;
+        mLastRequestFuncCode = funccode;
+        mLastRequestPacket = packet_id;
+        // the frame ends where its last stop bit is sampled; the request is only over at the end of that stop bit
+        mLastRequestEndingSample = ending_sample + mEndOfStopBitOffset;
+    }
+}
 
-            if( mSettings->mInverted == true )
-                data = ( ~data ) & bit_mask;
+void ModbusAnalyzer::TrackPolling( U8 devaddr, U8 funccode )
+{
+    // a request is told apart from others by its fixed fields (which registers, how many), not by the data it carries
+    const ModbusPduLayout& layout = *mRequestLayouts[ funccode ];
+    U32 field_bytes = 0;
+    for( U32 i = 0; i < layout.mFieldCount; i++ )
+        field_bytes += layout.mFields[ i ].mSize;
 
-            parity_error = false;
+    if( field_bytes > mAdu.mLength - 2 )
+        field_bytes = mAdu.mLength - 2;
 
-            if( mSettings->mParity != ModbusAnalyzerEnums::NoneOne && mSettings->mParity != ModbusAnalyzerEnums::NoneTwo )
-            {
-                mModbus->Advance( mParityBitOffset );
-                bool is_even = AnalyzerHelpers::IsEven( AnalyzerHelpers::GetOnesCount( data ) );
-
-                if( mSettings->mParity == ModbusAnalyzerEnums::EvenOne )
-                {
-                    if( is_even == true )
-                    {
-                        if( mModbus->GetBitState() != mBitLow ) // we expect a low bit, to keep the parity even.
-                            parity_error = true;
-                    }
-                    else
-                    {
-                        if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, to force parity even.
-                            parity_error = true;
-                    }
-                }
-                else // if( mSettings->mParity == ModbusAnalyzerEnums::OddOne )
-                {
-                    if( is_even == false )
-                    {
-                        if( mModbus->GetBitState() != mBitLow ) // we expect a low bit, to keep the parity odd.
-                            parity_error = true;
-                    }
-                    else
-                    {
-                        if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, to force parity odd.
-                            parity_error = true;
-                    }
-                }
-
-                marker_location += mParityBitOffset;
-                if( !parity_error )
-                    mResults->AddMarker( marker_location, AnalyzerResults::Square, mSettings->mInputChannel );
-                else
-                    mResults->AddMarker( marker_location, AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-            }
-            else if( mSettings->mParity == ModbusAnalyzerEnums::NoneTwo )
-            {
-                mModbus->Advance( mStartOfStopBitOffset );
-                if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, for the stop bit
-                {
-                    mResults->AddMarker( mModbus->GetSampleNumber(), AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-                    framing_error = true;
-                }
-            }
+    mPollingCycles.AddRequest( devaddr, funccode, mAdu.mBytes + 2, field_bytes, mAdu.mStartingSamples[ 0 ] );
+}
 
-            mModbus->Advance( mStartOfStopBitOffset );
-            if( mModbus->GetBitState() != mBitHigh ) // we expect a high bit, for the stop bit
-            {
-                mResults->AddMarker( mModbus->GetSampleNumber(), AnalyzerResults::ErrorDot, mSettings->mInputChannel );
-                framing_error = true;
-            }
+bool ModbusAnalyzer::AduFitsLayout( const ModbusPduLayout& layout )
+{
+    // the device address and function code are already behind us
+    U32 checksum_size = mAsciiMode ? 1 : 2;
+    U32 pdu_end = MeasurePdu( layout, mAduIndex );
+    if( pdu_end + checksum_size != mAdu.mLength )
+        return false;
+
+    if( !mAsciiMode )
+    {
+        U16 crc = crc16_modbus( mAdu.mBytes, pdu_end );
+        return mAdu.mBytes[ pdu_end ] == ( crc & 0x00FF ) && mAdu.mBytes[ pdu_end + 1 ] == ( crc >> 8 );
+    }
+    else
+    {
+        U8 lrc = 0x00;
+        for( U32 i = 0; i < pdu_end; i++ )
+            lrc += mAdu.mBytes[ i ];
+
+        lrc = -lrc;
+        return mAdu.mBytes[ pdu_end ] == lrc;
+    }
+}
+
+U32 ModbusAnalyzer::MeasurePdu( const ModbusPduLayout& layout, U32 index )
+{
+    // Where ParsePdu() would end up if it was handed this layout, without adding any frames. Anything past mAdu.mLength means the
+    // layout doesn't fit.
+    S64 length = -1;
+
+    for( U32 i = 0; i < layout.mFieldCount; i++ )
+    {
+        const ModbusPduField& field = layout.mFields[ i ];
+        if( index + field.mSize > mAdu.mLength )
+            return mAdu.mLength + 1;
+
+        U32 value = mAdu.mBytes[ index ];
+        if( field.mSize == 2 )
+            value = ( value << 8 ) | mAdu.mBytes[ index + 1 ];
+        if( field.mSlot == ModbusPduEnums::SlotLength )
+            length = value;
+
+        index += field.mSize;
+    }
 
-            frame_ending_sample = mModbus->GetSampleNumber();
+    if( layout.mBody == ModbusPduEnums::NoBody )
+        return index;
 
-            value = value + ASCII2INT( data );
-            return value;
+    if( length < 0 )
+    {
+        U32 checksum_size = mAsciiMode ? 1 : 2;
+        return ( mAdu.mLength > index + checksum_size ) ? mAdu.mLength - checksum_size : index;
+    }
+
+    length = length * layout.mLengthUnit - layout.mLengthAdjust;
+    U32 body_end = index + ( length > 0 ? U32( length ) : 0 );
+
+    if( layout.mBody != ModbusPduEnums::Groups )
+        return body_end;
+
+    while( index < body_end && index <= mAdu.mLength )
+        index = MeasurePdu( *layout.mGroup, index );
+
+    return index;
+}
+
+bool ModbusAnalyzer::ParsePdu( const ModbusPduLayout& layout, Frame& frame, U64& frame_ending_sample )
+{
+    U64 fields_starting_sample = frame.mStartingSampleInclusive;
+    U32 body_length = ReadPduFields( layout, frame, fields_starting_sample, frame_ending_sample );
+
+    // The fixed fields fit in the frame, the body doesn't: a frame with a body carries the whole ADU as its payload, and the results
+    // read the body and the checksum back from there. An ADU cut short before the body starts has nothing more to show.
+    bool has_body = layout.mBody != ModbusPduEnums::NoBody && !mAduTruncated;
+    if( has_body )
+        SkipPduBody( layout, body_length, frame_ending_sample );
+
+    // RTU sends the CRC low byte first; ASCII has a single LRC byte
+    U64 byte_starting_sample = 0;
+    U64 checksum = GetAduByte( byte_starting_sample, frame_ending_sample );
+    if( !mAsciiMode )
+        checksum |= GetAduByte( byte_starting_sample, frame_ending_sample ) << 8;
+
+    if( !AduChecksumMatches() )
+        frame.mFlags |= FLAG_CHECKSUM_ERROR;
+
+    // with a body, the low bits keep the length field
+    if( !has_body )
+        frame.mData1 |= checksum;
+
+    return has_body;
+}
+
+U32 ModbusAnalyzer::ReadPduFields( const ModbusPduLayout& layout, Frame& frame, U64& frame_starting_sample, U64& frame_ending_sample )
+{
+    S64 length = -1;
+
+    for( U32 i = 0; i < layout.mFieldCount; i++ )
+    {
+        const ModbusPduField& field = layout.mFields[ i ];
+        U64 byte_starting_sample = frame_starting_sample;
+
+        U64 value = GetAduByte( byte_starting_sample, frame_ending_sample );
+        if( i == 0 )
+            frame_starting_sample = byte_starting_sample;
+        if( field.mSize == 2 )
+            value = ( value << 8 ) | GetAduByte( byte_starting_sample, frame_ending_sample );
+
+        switch( field.mSlot )
+        {
+        case ModbusPduEnums::SlotFunctionCode:
+            frame.mData1 |= value << 48;
+            break;
+        case ModbusPduEnums::SlotPayload1:
+            frame.mData1 |= value << 32;
+            break;
+        case ModbusPduEnums::SlotPayload2:
+            frame.mData1 |= value << 16;
+            break;
+        case ModbusPduEnums::SlotLength:
+            frame.mData1 |= value;
+            length = value;
+            break;
+        case ModbusPduEnums::SlotPayload3:
+            frame.mData2 |= value;
+            break;
+        case ModbusPduEnums::SlotPayload4:
+            frame.mData2 |= value << 16;
+            break;
         }
     }
+
+    if( layout.mBody == ModbusPduEnums::NoBody )
+        return 0;
+
+    if( length < 0 )
+    {
+        // nothing says how long the body is, so it runs up to the checksum
+        U32 checksum_size = mAsciiMode ? 1 : 2;
+        return ( mAdu.mLength > mAduIndex + checksum_size ) ? mAdu.mLength - mAduIndex - checksum_size : 0;
+    }
+
+    length = length * layout.mLengthUnit - layout.mLengthAdjust;
+    return length > 0 ? U32( length ) : 0;
+}
+
+void ModbusAnalyzer::SkipPduBody( const ModbusPduLayout& layout, U32 length, U64& frame_ending_sample )
+{
+    U32 body_end = mAduIndex + length;
+    U64 byte_starting_sample = 0;
+
+    while( !mAduTruncated && mAduIndex < body_end )
+    {
+        if( layout.mBody == ModbusPduEnums::Groups )
+        {
+            // a group's header is only needed for the length of what follows it
+            Frame group;
+            group.mData1 = 0;
+            group.mData2 = 0;
+            U32 group_length = ReadPduFields( *layout.mGroup, group, byte_starting_sample, frame_ending_sample );
+            SkipPduBody( *layout.mGroup, group_length, frame_ending_sample );
+            continue;
+        }
+
+        GetAduByte( byte_starting_sample, frame_ending_sample );
+    }
+}
+
+BitState ModbusAnalyzer::GetBitStateAt( U64 sample_number, BitState& bit_state )
+{
+    // sample points only ever move forward; an odd number of transitions on the way there flips the level
+    if( mModbus->AdvanceToAbsPosition( sample_number ) & 1 )
+        bit_state = Toggle( bit_state );
+
+    return bit_state;
 }
 
 int ModbusAnalyzer::ASCII2INT( char value )
@@ -2856,41 +1185,3 @@ int ModbusAnalyzer::ASCII2INT( char value )
         return 0;
     }
 }
-
-U16 ModbusAnalyzer::update_CRC( U16 crc, U8 c )
-{
-    U16 tmp, short_c;
-
-    short_c = 0x00ff & ( U16 )c;
-
-    // if ( ! crc_tab16_init ) init_crc16_tab();
-
-    tmp = crc ^ short_c;
-    crc = ( crc >> 8 ) ^ crc_tab16[ tmp & 0xff ];
-
-    return crc;
-}
-
-void ModbusAnalyzer::init_crc16_tab( void )
-{
-    int i, j;
-    U16 crc, c;
-
-    for( i = 0; i < 256; i++ )
-    {
-        crc = 0;
-        c = ( U16 )i;
-
-        for( j = 0; j < 8; j++ )
-        {
-            if( ( crc ^ c ) & 0x0001 )
-                crc = ( crc >> 1 ) ^ 0xA001;
-            else
-                crc = crc >> 1;
-
-            c = c >> 1;
-        }
-
-        crc_tab16[ i ] = crc;
-    }
-}
@@ -3,11 +3,40 @@
 
 #include <Analyzer.h>
 #include "ModbusAnalyzerResults.h"
+#include "ModbusAnalyzerSettings.h"
 #include "ModbusSimulationDataGenerator.h"
 #include "ModbusAnalyzerModbusExtension.h"
+#include "ModbusPduLayouts.h"
+#include "ModbusTrafficStats.h"
+#include "ModbusPollingCycles.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <chrono>
+#include <mutex>
+
+// Frames are handed to the GUI in batches of up to this many, and at least this often while they keep coming
+#define MODBUS_COMMIT_BATCH_FRAMES 1024
+#define MODBUS_COMMIT_INTERVAL_MS 50
+
+// One application data unit as it came off the wire (device address, PDU and checksum), with where each byte sits in the capture
+struct ModbusAdu
+{
+    U8 mBytes[ MODBUS_MAX_ADU_SIZE ];
+    U64 mStartingSamples[ MODBUS_MAX_ADU_SIZE ];
+    U64 mEndingSamples[ MODBUS_MAX_ADU_SIZE ];
+    U32 mLength;
+};
+
+// One channel being decoded; full duplex modes have a second one for the responses
+struct ModbusLine
+{
+    AnalyzerChannelData* mData;
+    Channel mChannel;
+    U8 mFrameType; // FRAME_TYPE_REQUEST_LINE or FRAME_TYPE_RESPONSE_LINE
+    bool mRtuLineActive;
+    U64 mLastFrameEndingSample;
+};
 
 class ModbusAnalyzerSettings;
 class ModbusAnalyzer : public Analyzer2
@@ -24,6 +53,8 @@ class ModbusAnalyzer : public Analyzer2
     virtual const char* GetAnalyzerName() const;
     virtual bool NeedsRerun();
 
+    // any thread; a copy of the statistics so far, consistent with each other even while the analyzer is still running
+    void GetStatistics( ModbusTrafficStats& traffic_stats, ModbusPollingCycles& polling_cycles ) const;
 
 #pragma warning( push )
 #pragma warning(                                                                                                                           \
@@ -31,13 +62,41 @@ class ModbusAnalyzer : public Analyzer2
 
   protected: // functions
     void ComputeSampleOffsets();
-    U64 GetNextByteModbus( U32 num_bits, U64 bit_mask, U64& frame_starting_sample, U64& frame_ending_sample );
+    bool ReadAdu();
+    void ReadRtuAdu();
+    bool ReadAsciiAdu();
+    void AppendAduByte( U8 value, U64 starting_sample, U64 ending_sample );
+    U64 GetAduByte( U64& frame_starting_sample, U64& frame_ending_sample );
+    bool AduChecksumMatches();
+    void KeepClearOfPreviousFrame( Frame& frame );
+    void CommitIfDue( U64 ending_sample );
+    void SelectLine( ModbusLine& line );
+    ModbusLine& NextLine();
+    void SelectPduLayouts();
+    bool AduIsResponse( U8 devaddr, U8 funccode );
+    bool AduAnswersRequest( U8 devaddr, U8 funccode );
+    U32 Turnaround();
+    void TrackTransaction( bool response, bool answers_request, U8 devaddr, U8 funccode, U64 packet_id, U64 ending_sample );
+    void TrackPolling( U8 devaddr, U8 funccode );
+    bool AduFitsLayout( const ModbusPduLayout& layout );
+    U32 MeasurePdu( const ModbusPduLayout& layout, U32 index );
+    bool ParsePdu( const ModbusPduLayout& layout, Frame& frame, U64& frame_ending_sample );
+    U32 ReadPduFields( const ModbusPduLayout& layout, Frame& frame, U64& frame_starting_sample, U64& frame_ending_sample );
+    void SkipPduBody( const ModbusPduLayout& layout, U32 length, U64& frame_ending_sample );
+    void SelectCharacterDecoder( U32 num_bits );
+    template <ModbusAnalyzerEnums::ParityAndStopbits Parity, bool Inverted, AnalyzerEnums::ShiftOrder ShiftOrder, U32 NumBits>
+    U64 DecodeCharacter( U64& character_starting_sample, U64& character_ending_sample );
+    BitState GetBitStateAt( U64 sample_number, BitState& bit_state );
     int ASCII2INT( char value );
 
   protected: // vars
     std::auto_ptr<ModbusAnalyzerSettings> mSettings;
     std::auto_ptr<ModbusAnalyzerResults> mResults;
-    AnalyzerChannelData* mModbus;
+    AnalyzerChannelData* mModbus; // the channel of mLine
+
+    ModbusLine mLines[ 2 ];
+    U32 mLineCount;
+    ModbusLine* mLine; // the line the current ADU is read from
 
     ModbusSimulationDataGenerator mSimulationDataGenerator;
     bool mSimulationInitilized;
@@ -47,13 +106,55 @@ class ModbusAnalyzer : public Analyzer2
     std::vector<U32> mSampleOffsets;
     U32 mParityBitOffset;
     U32 mStartOfStopBitOffset;
+    U32 mEndOfStopBitOffset; // from where the (last) stop bit is sampled to where the character ends
+
+    // RTU framing by inter-character silence (t1.5 / t3.5), in samples
+    U64 mInterCharacterTimeout;
+    U64 mInterFrameDelay;
+
+    // where the latest ending frame on either line ends, to flag full duplex overlaps
+    U64 mLastFrameEndingSample;
+
+    // frames added since the last CommitResults()
+    U32 mUncommittedFrames;
+    std::chrono::steady_clock::time_point mLastCommitTime;
+
+    // the ADU being parsed, and how far into it the parser is
+    ModbusAdu mAdu;
+    U32 mAduIndex;
+    bool mAduTruncated;
+    U32 mAduParityErrors; // characters of the ADU that failed their parity or stop bit checks
+    U32 mAduFramingErrors;
+    bool mAduMissedSilence; // an RTU ADU that started less than t3.5 after the previous one
+
     BitState mBitLow;
     BitState mBitHigh;
 
-    // Checksum caluclations for Modbus
-    U16 crc_tab16[ 256 ];
-    void init_crc16_tab( void );
-    U16 update_CRC( U16 crc, U8 c );
+    // Byte sampler, picked once per run by SelectCharacterDecoder() to match the line settings
+    typedef U64 ( ModbusAnalyzer::*CharacterDecoder )( U64& character_starting_sample, U64& character_ending_sample );
+    CharacterDecoder mDecodeCharacter;
+    U64 mCharacterSpan;
+    bool mAsciiMode;
+    bool mAddBitMarkers;
+    bool mAddErrorMarkers;
+    bool mOddParity[ 256 ];
+
+    // how the PDU after each function code is laid out, in either direction
+    const ModbusPduLayout* mRequestLayouts[ 256 ];
+    const ModbusPduLayout* mResponseLayouts[ 256 ];
+
+    // the last request seen, while its response may still be on the way
+    bool mAwaitingResponse;
+    U8 mLastRequestDevAddr;
+    U8 mLastRequestFuncCode;
+    U64 mLastRequestPacket;
+    U64 mLastRequestEndingSample;
+    U64 mTransactionCount; // request/response pairs so far
+
+    // read by the export on the GUI thread, so only touched with mStatsMutex held
+    mutable std::mutex mStatsMutex;
+    ModbusTrafficStats mTrafficStats;
+    ModbusPollingCycles mPollingCycles;
 
 #pragma warning( pop )
 };
@@ -45,13 +45,25 @@
 // 0x15 - 0xFFFF RESERVED
 
 
+// Largest ADU on a serial line: device address, 253 byte PDU and CRC
+#define MODBUS_MAX_ADU_SIZE 256
+
 // Flags used by AnalyzerResults
 #define FLAG_CHECKSUM_ERROR 0x80
 #define FLAG_REQUEST_FRAME 0x40
 #define FLAG_RESPONSE_FRAME 0x02
 #define FLAG_EXCEPTION_FRAME 0x04
-#define FLAG_DATA_FRAME 0x08
-#define FLAG_END_FRAME 0x01
-#define FLAG_FILE_SUBREQ 0x20
+#define FLAG_TRUNCATED_FRAME 0x10
+#define FLAG_OVERLAPPING_FRAME 0x08 // full duplex: starts before the last frame on the other line ended
+
+// Frame types, telling apart the two lines in the full duplex modes
+#define FRAME_TYPE_REQUEST_LINE 0
+#define FRAME_TYPE_RESPONSE_LINE 1
+
+// A response paired up with its request carries the turnaround (request end to response start, in samples) in mData2 bits 32-62 of
+// its first frame
+#define TURNAROUND_PAIRED 0x8000000000000000ull
+#define TURNAROUND_SHIFT 32
+#define TURNAROUND_MAX 0x7FFFFFFF
 
 #endif // MODBUS_ANALYZER_MODBUS_EXTENSION
\ No newline at end of file
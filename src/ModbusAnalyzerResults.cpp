@@ -2,8 +2,13 @@
 #include <AnalyzerHelpers.h>
 #include "ModbusAnalyzer.h"
 #include "ModbusAnalyzerSettings.h"
+#include "ModbusBinaryExport.h"
+#include "ModbusExportWriter.h"
+#include "ModbusPcapngExport.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 
 #pragma warning( disable : 4996 ) // warning C4996: 'sprintf': This function or variable may be unsafe. Consider using sprintf_s instead.
@@ -17,14 +22,39 @@ ModbusAnalyzerResults::~ModbusAnalyzerResults()
 {
 }
 
-void ModbusAnalyzerResults::GenerateBubbleText( U64 frame_index, Channel& /*channel*/,
-                                                DisplayBase display_base ) // unrefereced vars commented out to remove warnings.
+void ModbusAnalyzerResults::GenerateBubbleText( U64 frame_index, Channel& channel, DisplayBase display_base )
+{
+    ModbusStringCache::Kind kind = ModbusStringCache::InputBubble;
+    if( mSettings->IsFullDuplex() && channel == mSettings->mResponseChannel )
+        kind = ModbusStringCache::ResponseBubble;
+
+    ModbusStringCache::Strings strings = mStringCache.Find( frame_index, display_base, kind );
+    if( strings )
+    {
+        AnalyzerResults::ClearResultStrings();
+        for( U32 i = 0; i < strings->size(); i++ )
+            AnalyzerResults::AddResultString( ( *strings )[ i ].c_str() );
+        return;
+    }
+
+    FormatBubbleText( frame_index, channel, display_base );
+    mStringCache.Add( frame_index, display_base, kind, mBubbleStrings );
+}
+
+void ModbusAnalyzerResults::FormatBubbleText( U64 frame_index, Channel& channel, DisplayBase display_base )
 {
     // we only need to pay attention to 'channel' if we're making bubbles for more than one channel (as set by
-    // AddChannelBubblesWillAppearOn)
+    // AddChannelBubblesWillAppearOn), which is the case in full duplex modes: each frame belongs on the line it was read from
     ClearResultStrings();
     Frame frame = GetFrame( frame_index );
 
+    if( mSettings->IsFullDuplex() )
+    {
+        Channel& frame_channel = frame.mType == FRAME_TYPE_RESPONSE_LINE ? mSettings->mResponseChannel : mSettings->mInputChannel;
+        if( frame_channel != channel )
+            return;
+    }
+
     bool framing_error = false;
     if( ( frame.mFlags & FRAMING_ERROR_FLAG ) != 0 )
         framing_error = true;
@@ -39,568 +69,39 @@ void ModbusAnalyzerResults::GenerateBubbleText( U64 frame_index, Channel& /*chan
 
     if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
         mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer ||
-        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
     {
-        char DeviceAddrStr[ 128 ];
-        U8 DeviceAddr = ( frame.mData1 & 0xFF00000000000000 ) >> 56;
-        AnalyzerHelpers::GetNumberString( DeviceAddr, display_base, bits_per_transfer, DeviceAddrStr, 128 );
+        ModbusFrameFormatter formatter( display_base, bits_per_transfer );
+        char text_str[ MODBUS_TEXT_SIZE ];
+        ModbusTextBuffer text( text_str, sizeof( text_str ) );
 
-        char FunctionCodeStr[ 128 ];
-        U8 FunctionCode = ( frame.mData1 & 0x00FF000000000000 ) >> 48;
-        AnalyzerHelpers::GetNumberString( FunctionCode, display_base, bits_per_transfer, FunctionCodeStr, 128 );
-
-        char Payload1Str[ 128 ];
-        U16 Payload1 = ( frame.mData1 & 0x0000FFFF00000000 ) >> 32;
-        AnalyzerHelpers::GetNumberString( Payload1, display_base, bits_per_transfer, Payload1Str, 128 );
-
-        char Payload2Str[ 128 ];
-        U16 Payload2 = ( frame.mData1 & 0x00000000FFFF0000 ) >> 16;
-        AnalyzerHelpers::GetNumberString( Payload2, display_base, bits_per_transfer, Payload2Str, 128 );
-
-        char Payload3Str[ 128 ];
-        U16 Payload3 = ( frame.mData2 & 0x000000000000FFFF );
-        AnalyzerHelpers::GetNumberString( Payload3, display_base, bits_per_transfer, Payload3Str, 128 );
-
-        char Payload4Str[ 128 ];
-        U16 Payload4 = ( frame.mData2 & 0x00000000FFFF0000 ) >> 16;
-        AnalyzerHelpers::GetNumberString( Payload4, display_base, bits_per_transfer, Payload4Str, 128 );
+        // from shortest to longest: the function code, its name, the sub-function, and the whole frame
+        if( frame.mFlags & FLAG_EXCEPTION_FRAME )
+            text.Append( "NAK" );
+        else
+            formatter.AppendNumber( text, ( frame.mData1 >> 48 ) & 0xFF );
+        AddResultString( text.GetText() );
 
-        char ChecksumStr[ 128 ];
-        U16 Checksum = ( frame.mData1 & 0x000000000000FFFF );
-        AnalyzerHelpers::GetNumberString( Checksum, display_base, bits_per_transfer, ChecksumStr, 128 );
+        text.Clear();
+        formatter.AppendName( text, frame );
+        AddResultString( text.GetText() );
 
-        char result_str[ 256 ] = { '\0' };
-        char Error_str[ 128 ] = { '\0' };
-        if( frame.mFlags & FLAG_REQUEST_FRAME )
+        const char* sub_function = formatter.GetSubFunctionName( frame );
+        if( sub_function != NULL )
         {
-            AddResultString( FunctionCodeStr );
-            switch( FunctionCode )
-            {
-            case FUNCCODE_READ_COILS:
-                AddResultString( "Read Coils" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Coils (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DISCRETE_INPUTS:
-                AddResultString( "Read Discrete Inputs" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Discrete Inputs (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_HOLDING_REGISTERS:
-                AddResultString( "Read Holding Registers" );
-                sprintf( result_str, "DeviceID: %s, Func: Holding Registers (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_INPUT_REGISTER:
-                AddResultString( "Read Input Registers" );
-                sprintf( result_str, "DeviceID: %s, Func: Input Registers (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_COIL:
-                AddResultString( "Write Single Coil" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Coil (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_REGISTER:
-                AddResultString( "Write Single Register" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Register (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_EXCEPTION_STATUS:
-                AddResultString( "Read Exception Status" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Exception Status (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_DIAGNOSTIC:
-
-                switch( Payload1 )
-                {
-                case RETURN_QUERY_DATA:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Return Query Data" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Return Query Data (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RESTART_COMMUNICATIONS_OPTION:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Restart Comms Option" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Restart Comms Option (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_DIAGNOSTIC_REGISTER:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Return Diag Reg" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Return Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CHANGE_ASCII_INPUT_DELIM:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Change ASCII Input Delim" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Change ASCII Input Delim (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FORCE_LISTEN_ONLY_MODE:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Force Listen Only Mode" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Force Listen Only Mode (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_COUNTERS_AND_DIAG_REGISTER:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Clr Counters And Diag Reg" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Clr Counters And Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_MESSAGE_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Bus Msg Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_COMM_ERROR_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Bus Comm Err Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Comm Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Bus Excpt Err Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Excpt Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_MESSAGE_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Server Msg Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NO_RESPONSE_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Server No Resp Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server No Resp Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NAK_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Server NAK Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server NAK Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_BUSY_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Server Busy Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server Busy Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_CHAR_OVERRUN_COUNT:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Bus Char Overrun Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Char Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                    AddResultString( "Diagnostics" );
-                    AddResultString( "Diagnostics - Clear Overrun Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Clear Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                }
-                break;
-            case FUNCCODE_GET_COM_EVENT_COUNTER:
-                AddResultString( "Get Comm Event Counter" );
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Counter (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_LOG:
-                AddResultString( "Get Comm Event Log" );
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Log (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_COILS:
-                AddResultString( "Write Multiple Coils" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Coils (%s), StartAddr: %s, Qty: %s, ByteCount: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                AddResultString( "Write Multiple Registers" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Registers (%s), StartAddr: %s, Qty: %s, ByteCount: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_REPORT_SERVER_ID:
-                AddResultString( "Report Server ID" );
-                sprintf( result_str, "DeviceID: %s, Func: Report Server ID (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FILE_RECORD:
-                AddResultString( "Read File Record" );
-                sprintf( result_str, "DeviceID: %s, Func: Read File Record (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_FILE_RECORD:
-                AddResultString( "Write File Record" );
-                sprintf( result_str, "DeviceID: %s, Func: Write File Record (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_MASK_WRITE_REGISTER:
-                AddResultString( "Mask Write Register" );
-                sprintf( result_str, "DeviceID: %s, Func: Mask Write Register (%s), RefAddr: %s, And_Mask: %s, OR_Mask: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                AddResultString( "Read/Write Multiple Registers" );
-                sprintf( result_str,
-                         "DeviceID: %s, Func: Read/Write Multiple Registers (%s), ReadStartAddr: %s, ReadQty: %s, WriteStartAddr: %s, "
-                         "WriteQty: %s, ByteCount: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload4Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FIFO_QUEUE:
-                AddResultString( "Read FIFO Queue" );
-                sprintf( result_str, "DeviceID: %s, Func: Read FIFO Queue (%s), Addr: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DEVICE_ID:
-                AddResultString( "Read Device ID" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Device ID (%s), MEI: %s, ReadIDCode: %s, ObjID: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            }
+            text.Append( " - " );
+            text.Append( sub_function );
+            AddResultString( text.GetText() );
         }
-        else if( frame.mFlags & FLAG_RESPONSE_FRAME )
-        {
-            AddResultString( FunctionCodeStr );
-            switch( FunctionCode )
-            {
-            case FUNCCODE_READ_COILS:
-                AddResultString( "Read Coils [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Coils [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_DISCRETE_INPUTS:
-                AddResultString( "Read Discrete Inputs [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Discrete Inputs [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_HOLDING_REGISTERS:
-                AddResultString( "Read Holding Registers [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Holding Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_INPUT_REGISTER:
-                AddResultString( "Read Input Registers [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Input Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_COIL:
-                AddResultString( "Write Single Coil [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Coil [ACK] (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_REGISTER:
-                AddResultString( "Write Single Register [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Register [ACK] (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_EXCEPTION_STATUS:
-                AddResultString( "Read Exception Status [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Exception Status [ACK] (%s), Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_DIAGNOSTIC:
-
-                switch( Payload1 )
-                {
-                case RETURN_QUERY_DATA:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Return Query Data" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Return Query Data (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RESTART_COMMUNICATIONS_OPTION:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK]- Restart Comms Option" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Restart Comms Option (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_DIAGNOSTIC_REGISTER:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Return Diag Reg" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Return Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CHANGE_ASCII_INPUT_DELIM:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Change ASCII Input Delim" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Change ASCII Input Delim (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FORCE_LISTEN_ONLY_MODE:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Force Listen Only Mode" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Force Listen Only Mode (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_COUNTERS_AND_DIAG_REGISTER:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Clr Counters And Diag Reg" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Clr Counters And Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_MESSAGE_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Bus Msg Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_COMM_ERROR_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Bus Comm Err Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Comm Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Bus Excpt Err Cnt" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Excpt Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_MESSAGE_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Server Msg Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NO_RESPONSE_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Server No Resp Cnt" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server No Resp Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NAK_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Server NAK Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server NAK Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_BUSY_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Server Busy Cnt" );
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server Busy Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_CHAR_OVERRUN_COUNT:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Bus Char Overrun Cnt" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Char Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                    AddResultString( "Diagnostics [ACK]" );
-                    AddResultString( "Diagnostics [ACK] - Clear Overrun Cnt" );
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Clear Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                }
-                break;
-            case FUNCCODE_GET_COM_EVENT_COUNTER:
-                AddResultString( "Get Comm Event Counter [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Counter [ACK] (%s), Status: %s, Count: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_LOG:
-                AddResultString( "Get Comm Event Log [ACK]" );
-                sprintf( result_str,
-                         "DeviceID: %s, Func: Get Comm Event Log [ACK] (%s), Status: %s, EventCnt: %s, MsgCnt: %s, ByteCount: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload4Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_COILS:
-                AddResultString( "Write Multiple Coils [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Coils [ACK] (%s), StartAddr: %s, Qty: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                AddResultString( "Write Multiple Registers [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Registers [ACK] (%s), StartAddr: %s, Qty: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_REPORT_SERVER_ID:
-                AddResultString( "Report Server ID [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Report Server ID [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_FILE_RECORD:
-                AddResultString( "Read File Record [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read File Record [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_FILE_RECORD:
-                AddResultString( "Write File Record [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write File Record [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_MASK_WRITE_REGISTER:
-                AddResultString( "Mask Write Register [ACK]" );
-                sprintf( result_str,
-                         "DeviceID: %s, Func: Mask Write Register [ACK] (%s), RefAddr: %s, And_Mask: %s, OR_Mask: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                AddResultString( "Read/Write Multiple Registers [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read/Write Multiple Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr,
-                         FunctionCodeStr, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FIFO_QUEUE:
-                AddResultString( "Read FIFO Queue [ACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read FIFO Queue [ACK] (%s), ByteCount: %s, FIFO Count: %s", DeviceAddrStr,
-                         FunctionCodeStr, ChecksumStr, Payload2Str );
-                break;
-            case FUNCCODE_READ_DEVICE_ID:
-                AddResultString( "Read Device ID" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Device ID (%s), MEI: %s, ReadIDCode: %s, ObjID: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            }
-        }
-        else if( frame.mFlags & FLAG_EXCEPTION_FRAME )
-        {
-            AddResultString( "NAK" );
-            switch( FunctionCode - 0x80 )
-            {
-            case FUNCCODE_READ_COILS:
-                AddResultString( "Read Coils [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Coils [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DISCRETE_INPUTS:
-                AddResultString( "Read Discrete Inputs [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Discrete Inputs [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_HOLDING_REGISTERS:
-                AddResultString( "Read Holding Registers [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Holding Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_INPUT_REGISTER:
-                AddResultString( "Read Input Registers [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Input Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_COIL:
-                AddResultString( "Write Single Coil [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Coil [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_REGISTER:
-                AddResultString( "Write Single Register [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Register [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_EXCEPTION_STATUS:
-                AddResultString( "Read Exception Status [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Exception Status [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_DIAGNOSTIC:
-                AddResultString( "Diagnostics [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Diagnostics [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_COUNTER:
-                AddResultString( "Get Comm Event Counter [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Counter [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_LOG:
-                AddResultString( "Get Comm Event Log [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Log [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_COILS:
-                AddResultString( "Write Multiple Coils [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Coils [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                AddResultString( "Write Multiple Registers [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_REPORT_SERVER_ID:
-                AddResultString( "Report Server ID [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Report Server ID [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FILE_RECORD:
-                AddResultString( "Read File Record [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read File Record [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_FILE_RECORD:
-                AddResultString( "Write File Record [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Write File Record [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_MASK_WRITE_REGISTER:
-                AddResultString( "Mask Write Register [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Mask Write Register [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                AddResultString( "Read/Write Multiple Registers [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read/Write Multiple Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FIFO_QUEUE:
-                AddResultString( "Read FIFO Queue [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read FIFO Queue [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DEVICE_ID:
-                AddResultString( "Read Device ID [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: Read Device ID [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            default:
-                AddResultString( "User Defined Function [NACK]" );
-                sprintf( result_str, "DeviceID: %s, Func: User Defined Function [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            }
-        }
-        else if( frame.mFlags & FLAG_FILE_SUBREQ )
-        {
-            AddResultString( "SubRequest Data" );
-            sprintf( result_str, "SubRequest - RefType: %s, FileNum: %s, RecordNum: %s, RecordLen: %s", FunctionCodeStr, Payload1Str,
-                     Payload2Str, ChecksumStr );
-        }
-        else if( frame.mFlags & FLAG_DATA_FRAME )
-        {
-            AddResultString( Payload1Str );
-            AddResultString( "Data" );
-            sprintf( result_str, "Value: %s", Payload1Str );
-        }
-        else if( frame.mFlags & FLAG_END_FRAME )
-        {
-            AddResultString( ChecksumStr );
-            AddResultString( "ChkSum" );
-            sprintf( result_str, " Checksum: %s", ChecksumStr );
-        }
-
-        if( frame.mFlags & FLAG_CHECKSUM_ERROR )
-            strcat( result_str, " (Invalid Checksum!)" );
 
-        AddResultString( result_str );
+        // a bubble only has room for the first few values
+        text.Clear();
+        AppendFrameText( text, frame_index, frame, formatter, true, 8 );
+        AddResultString( text.GetText() );
     }
     else
     {
@@ -661,555 +162,618 @@ void ModbusAnalyzerResults::GenerateBubbleText( U64 frame_index, Channel& /*chan
     }
 }
 
-void ModbusAnalyzerResults::GenerateExportFile( const char* file, DisplayBase display_base, U32 /*export_type_user_id*/ )
+void ModbusAnalyzerResults::GenerateExportFile( const char* file, DisplayBase display_base, U32 export_type_user_id )
 {
-    // export_type_user_id is only important if we have more than one export type.
-    std::stringstream ss;
+    if( export_type_user_id == ModbusAnalyzerEnums::ExportTrafficStatistics )
+    {
+        GenerateTrafficStatisticsFile( file, display_base );
+        return;
+    }
+
+    if( export_type_user_id == ModbusAnalyzerEnums::ExportBinary )
+    {
+        GenerateBinaryFile( file );
+        return;
+    }
+
+    if( export_type_user_id == ModbusAnalyzerEnums::ExportPcapng )
+    {
+        GeneratePcapngFile( file );
+        return;
+    }
+
+    if( export_type_user_id == ModbusAnalyzerEnums::ExportColumns )
+    {
+        GenerateColumnsFile( file );
+        return;
+    }
 
     U64 trigger_sample = mAnalyzer->GetTriggerSample();
     U32 sample_rate = mAnalyzer->GetSampleRate();
     U64 num_frames = GetNumFrames();
 
-    void* f = AnalyzerHelpers::StartFile( file );
+    // closes the file on the way out, cancelled or not
+    ModbusExportWriter writer( file );
 
     if( mSettings->mModbusMode == ModbusAnalyzerEnums::Normal )
     {
         // Normal case -- not MP mode.
-        ss << "Time [s],Value,Parity Error,Framing Error" << std::endl;
+        writer.Append( "Time [s],Value,Parity Error,Framing Error\n" );
+
+        ModbusFrameFormatter formatter( display_base, mSettings->mBitsPerTransfer );
 
-        for( U32 i = 0; i < num_frames; i++ )
+        // there are no ADUs to index here, but the filtered export still keeps to its time range
+        U64 first_frame = 0;
+        U64 end_frame = num_frames;
+        if( export_type_user_id == ModbusAnalyzerEnums::ExportFilteredFrames )
         {
-            Frame frame = GetFrame( i );
+            ModbusFrameQuery query;
+            GetExportFilter( query );
+            FindFrameRange( query, first_frame, end_frame );
+        }
+        U64 export_count = end_frame - first_frame;
 
-            // static void GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32
-            // result_string_max_length );
-            char time_str[ 128 ];
-            AnalyzerHelpers::GetTimeString( frame.mStartingSampleInclusive, trigger_sample, sample_rate, time_str, 128 );
+        ModbusExportWriter::ProgressCallback progress = [&]( U64 lines_written ) {
+            return UpdateExportProgressAndCheckForCancel( lines_written, export_count );
+        };
 
-            char number_str[ 128 ];
-            AnalyzerHelpers::GetNumberString( frame.mData1, display_base, mSettings->mBitsPerTransfer, number_str, 128 );
+        ModbusExportWriter::FrameFetcher fetch_frame = [&]( U64 i ) { return GetFrame( first_frame + i ); };
 
-            ss << time_str << "," << number_str;
+        ModbusExportWriter::LineFormatter format_line = [&]( U64, const Frame& frame, ModbusTextBuffer& line ) {
+            ModbusFrameFormatter::AppendTime( line, frame.mStartingSampleInclusive, trigger_sample, sample_rate );
+            line.Append( "," );
+            formatter.AppendNumber( line, frame.mData1 );
 
             if( ( frame.mFlags & PARITY_ERROR_FLAG ) != 0 )
-                ss << ",Error,";
+                line.Append( ",Error," );
             else
-                ss << ",,";
+                line.Append( ",," );
 
             if( ( frame.mFlags & FRAMING_ERROR_FLAG ) != 0 )
-                ss << "Error";
-
+                line.Append( "Error" );
 
-            ss << std::endl;
+            line.Append( "\n" );
+        };
 
-            AnalyzerHelpers::AppendToFile( ( U8* )ss.str().c_str(), ss.str().length(), f );
-            ss.str( std::string() );
-
-            if( UpdateExportProgressAndCheckForCancel( i, num_frames ) == true )
-            {
-                AnalyzerHelpers::EndFile( f );
-                return;
-            }
-        }
+        if( !writer.WriteLines( export_count, 256, fetch_frame, format_line, progress, formatter.IsReentrant() ) )
+            return;
     }
     else if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient ||
              mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
              mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
-             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer )
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex ||
+             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
     {
         // Modbus Mode
-        ss << "Time [s], DeviceID, Function Code, Message" << std::endl;
+        writer.Append( "Time [s], DeviceID, Function Code, Message\n" );
+
+        // the same text as the bubbles and the data table, though at the full character width as the export always had it
+        ModbusFrameFormatter formatter( display_base, mSettings->mBitsPerTransfer );
+
+        // The filtered export only visits the frames in its time range, found by binary search, and of those only the ones the
+        // index turns up, if the filter has anything for it. Nothing outside of that is even looked at.
+        U64 first_frame = 0;
+        U64 end_frame = num_frames;
+        bool use_index = false;
+        std::vector<U64> frame_indexes;
+        if( export_type_user_id == ModbusAnalyzerEnums::ExportFilteredFrames )
+        {
+            ModbusFrameQuery query;
+            GetExportFilter( query );
+            FindFrameRange( query, first_frame, end_frame );
+            use_index = query.UsesIndex();
+            if( use_index )
+                mFrameIndex.Find( query, first_frame, end_frame, frame_indexes );
+        }
+        U64 export_count = use_index ? frame_indexes.size() : end_frame - first_frame;
+
+        ModbusExportWriter::FrameFetcher fetch_frame = [&]( U64 i ) {
+            return GetFrame( use_index ? frame_indexes[ i ] : first_frame + i );
+        };
+
+        ModbusExportWriter::LineFormatter format_line = [&]( U64 i, const Frame& frame, ModbusTextBuffer& line ) {
+            U64 frame_index = use_index ? frame_indexes[ i ] : first_frame + i;
 
-        for( U32 i = 0; i < num_frames; i++ )
+            // every value goes into the export
+            ModbusFrameFormatter::AppendTime( line, frame.mStartingSampleInclusive, trigger_sample, sample_rate );
+            line.Append( "," );
+            AppendFrameText( line, frame_index, frame, formatter, false, 0xFFFFFFFF );
+            line.Append( "\n" );
+        };
+
+        ModbusExportWriter::ProgressCallback progress = [&]( U64 lines_written ) {
+            return UpdateExportProgressAndCheckForCancel( lines_written, export_count );
+        };
+
+        if( !writer.WriteLines( export_count, 128 + MODBUS_TEXT_SIZE, fetch_frame, format_line, progress, formatter.IsReentrant() ) )
+            return;
+    }
+    else
+    {
+        // MP mode.
+        writer.Append( "Time [s],Packet ID,Address,Data,Framing Error\n" );
+        U64 address = 0;
+
+        ModbusFrameFormatter formatter( display_base, mSettings->mBitsPerTransfer - 1 );
+        ModbusFrameFormatter decimal( Decimal, 64 );
+
+        for( U64 i = 0; i < num_frames; i++ )
         {
             Frame frame = GetFrame( i );
 
-            char DeviceAddrStr[ 128 ];
-            U8 DeviceAddr = ( frame.mData1 & 0xFF00000000000000 ) >> 56;
-            AnalyzerHelpers::GetNumberString( DeviceAddr, display_base, mSettings->mBitsPerTransfer, DeviceAddrStr, 128 );
+            if( ( frame.mFlags & MP_MODE_ADDRESS_FLAG ) != 0 )
+            {
+                address = frame.mData1;
+                continue;
+            }
 
-            char FunctionCodeStr[ 128 ];
-            U8 FunctionCode = ( frame.mData1 & 0x00FF000000000000 ) >> 48;
-            AnalyzerHelpers::GetNumberString( FunctionCode, display_base, mSettings->mBitsPerTransfer, FunctionCodeStr, 128 );
+            U64 packet_id = GetPacketContainingFrameSequential( i );
 
-            char Payload1Str[ 128 ];
-            U16 Payload1 = ( frame.mData1 & 0x0000FFFF00000000 ) >> 32;
-            AnalyzerHelpers::GetNumberString( Payload1, display_base, mSettings->mBitsPerTransfer, Payload1Str, 128 );
+            ModbusTextBuffer line = writer.StartLine( 512 );
+            ModbusFrameFormatter::AppendTime( line, frame.mStartingSampleInclusive, trigger_sample, sample_rate );
+            line.Append( "," );
+            if( packet_id != INVALID_RESULT_INDEX )
+                decimal.AppendNumber( line, packet_id );
+            line.Append( "," );
+            formatter.AppendNumber( line, address );
+            line.Append( "," );
+            formatter.AppendNumber( line, frame.mData1 );
+            line.Append( "," );
 
-            char Payload2Str[ 128 ];
-            U16 Payload2 = ( frame.mData1 & 0x00000000FFFF0000 ) >> 16;
-            AnalyzerHelpers::GetNumberString( Payload2, display_base, mSettings->mBitsPerTransfer, Payload2Str, 128 );
+            if( ( frame.mFlags & FRAMING_ERROR_FLAG ) != 0 )
+                line.Append( "Error" );
 
-            char Payload3Str[ 128 ];
-            U16 Payload3 = ( frame.mData2 & 0x000000000000FFFF );
-            AnalyzerHelpers::GetNumberString( Payload3, display_base, mSettings->mBitsPerTransfer, Payload3Str, 128 );
+            line.Append( "\n" );
+            writer.EndLine( line );
 
-            char Payload4Str[ 128 ];
-            U16 Payload4 = ( frame.mData2 & 0x00000000FFFF0000 ) >> 16;
-            AnalyzerHelpers::GetNumberString( Payload4, display_base, mSettings->mBitsPerTransfer, Payload4Str, 128 );
+            if( i % MODBUS_EXPORT_PROGRESS_LINES == 0 && UpdateExportProgressAndCheckForCancel( i, num_frames ) == true )
+                return;
+        }
+    }
 
-            char ChecksumStr[ 128 ];
-            U16 Checksum = ( frame.mData1 & 0x000000000000FFFF );
-            AnalyzerHelpers::GetNumberString( Checksum, display_base, mSettings->mBitsPerTransfer, ChecksumStr, 128 );
+    writer.Close();
+    UpdateExportProgressAndCheckForCancel( num_frames, num_frames );
+}
 
-            char time_str[ 128 ];
-            AnalyzerHelpers::GetTimeString( frame.mStartingSampleInclusive, trigger_sample, sample_rate, time_str, 128 );
+static bool PollingCycleComesFirst( const ModbusPollingCycle* a, const ModbusPollingCycle* b )
+{
+    if( a->mDevAddr != b->mDevAddr )
+        return a->mDevAddr < b->mDevAddr;
+    if( a->mFuncCode != b->mFuncCode )
+        return a->mFuncCode < b->mFuncCode;
+    return memcmp( a->mFields, b->mFields, MODBUS_POLLING_FIELD_BYTES ) < 0;
+}
 
-            char result_str[ 256 ] = { '\0' };
-            char Error_str[ 128 ] = { '\0' };
+void ModbusAnalyzerResults::GenerateTrafficStatisticsFile( const char* file, DisplayBase display_base )
+{
+    // Everything here was counted while decoding, so this doesn't have to look at a single frame. The analyzer may be running
+    // again as this goes, so it works from a copy.
+    ModbusTrafficStats stats;
+    ModbusPollingCycles polling_cycles;
+    mAnalyzer->GetStatistics( stats, polling_cycles );
+    U32 sample_rate = mAnalyzer->GetSampleRate();
+    std::stringstream ss;
+    char label[ 128 ];
 
-            if( frame.mFlags & FLAG_REQUEST_FRAME )
-            {
-                switch( FunctionCode )
-                {
-                case FUNCCODE_READ_COILS:
-                    sprintf( result_str, "%s, Read Coils (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_DISCRETE_INPUTS:
-                    sprintf( result_str, "%s, Read Discrete Inputs (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_HOLDING_REGISTERS:
-                    sprintf( result_str, "%s, Holding Registers (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_INPUT_REGISTER:
-                    sprintf( result_str, "%s, Input Registers (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_SINGLE_COIL:
-                    sprintf( result_str, "%s, Write Single Coil (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_SINGLE_REGISTER:
-                    sprintf( result_str, "%s, Write Single Register (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_EXCEPTION_STATUS:
-                    sprintf( result_str, "%s, Read Exception Status (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_DIAGNOSTIC:
-
-                    switch( Payload1 )
-                    {
-                    case RETURN_QUERY_DATA:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Return Query Data (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RESTART_COMMUNICATIONS_OPTION:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Restart Comms Option (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_DIAGNOSTIC_REGISTER:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Return Diag Reg (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case CHANGE_ASCII_INPUT_DELIM:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Change ASCII Input Delim (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case FORCE_LISTEN_ONLY_MODE:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Force Listen Only Mode (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case CLEAR_COUNTERS_AND_DIAG_REGISTER:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Clr Counters And Diag Reg (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_MESSAGE_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Bus Msg Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_COMM_ERROR_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Bus Comm Err Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Bus Excpt Err Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_MESSAGE_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Server Msg Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_NO_RESPONSE_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Server No Resp Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_NAK_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Server NAK Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_BUSY_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Server Busy Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_CHAR_OVERRUN_COUNT:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Bus Char Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                        sprintf( result_str, "%s, Diagnostics (%s), SubFunc: Clear Overrun Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    }
-                    break;
-                case FUNCCODE_GET_COM_EVENT_COUNTER:
-                    sprintf( result_str, "%s, Get Comm Event Counter (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_GET_COM_EVENT_LOG:
-                    sprintf( result_str, "%s, Get Comm Event Log (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_COILS:
-                    sprintf( result_str, "%s, Write Multiple Coils (%s), StartAddr: %s, Qty: %s, ByteCount: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                    sprintf( result_str, "%s, Write Multiple Registers (%s), StartAddr: %s, Qty: %s, ByteCount: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_REPORT_SERVER_ID:
-                    sprintf( result_str, "%s, Report Server ID (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_FILE_RECORD:
-                    sprintf( result_str, "%s, Read File Record (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_FILE_RECORD:
-                    sprintf( result_str, "%s, Write File Record (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_MASK_WRITE_REGISTER:
-                    sprintf( result_str, "%s, Mask Write Register (%s), RefAddr: %s, And_Mask: %s, OR_Mask: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                    sprintf( result_str,
-                             "%s, Read/Write Multiple Registers (%s), ReadStartAddr: %s, ReadQty: %s, WriteStartAddr: %s, WriteQty: %s, "
-                             "ByteCount: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload4Str, Payload3Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_FIFO_QUEUE:
-                    sprintf( result_str, "%s, Read FIFO Queue (%s), Addr: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr, Payload1Str,
-                             ChecksumStr );
-                    break;
-                case FUNCCODE_READ_DEVICE_ID:
-                    sprintf( result_str, "%s, Read Device ID (%s), MEI: %s, ReadIDCode: %s, ObjID: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                    break;
-                }
-            }
-            else if( frame.mFlags & FLAG_RESPONSE_FRAME )
-            {
-                switch( FunctionCode )
-                {
-                case FUNCCODE_READ_COILS:
-                    sprintf( result_str, "%s, Read Coils [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_DISCRETE_INPUTS:
-                    sprintf( result_str, " %s, Read Discrete Inputs [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                             ChecksumStr );
-                    break;
-                case FUNCCODE_READ_HOLDING_REGISTERS:
-                    sprintf( result_str, "%s, Holding Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_INPUT_REGISTER:
-                    sprintf( result_str, " %s, Input Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_SINGLE_COIL:
-                    sprintf( result_str, "%s, Write Single Coil [ACK] (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_SINGLE_REGISTER:
-                    sprintf( result_str, "%s, Write Single Register [ACK] (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_EXCEPTION_STATUS:
-                    sprintf( result_str, "%s, Read Exception Status [ACK] (%s), Value: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_DIAGNOSTIC:
-
-                    switch( Payload1 )
-                    {
-                    case RETURN_QUERY_DATA:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Return Query Data (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RESTART_COMMUNICATIONS_OPTION:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Restart Comms Option (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_DIAGNOSTIC_REGISTER:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Return Diag Reg (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case CHANGE_ASCII_INPUT_DELIM:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Change ASCII Input Delim (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case FORCE_LISTEN_ONLY_MODE:
-                        sprintf( result_str, " %s, Diagnostics [ACK] (%s), SubFunc: Force Listen Only Mode (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case CLEAR_COUNTERS_AND_DIAG_REGISTER:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Clr Counters And Diag Reg (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_MESSAGE_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Bus Msg Cnt (%s), Data: %s, ChkSum: %s", DeviceAddrStr,
-                                 FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_COMM_ERROR_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Bus Comm Err Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Bus Excpt Err Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_MESSAGE_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Server Msg Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_NO_RESPONSE_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Server No Resp Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_NAK_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Server NAK Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_SERVER_BUSY_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Server Busy Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case RETURN_BUS_CHAR_OVERRUN_COUNT:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Bus Char Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    case CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                        sprintf( result_str, "%s, Diagnostics [ACK] (%s), SubFunc: Clear Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                                 DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                        break;
-                    }
-                    break;
-                case FUNCCODE_GET_COM_EVENT_COUNTER:
-                    sprintf( result_str, " %s, Get Comm Event Counter [ACK] (%s), Status: %s, Count: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_GET_COM_EVENT_LOG:
-                    sprintf( result_str, "%s, Get Comm Event Log [ACK] (%s), Status: %s, EventCnt: %s, MsgCnt: %s, ByteCount: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload4Str, Payload3Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_COILS:
-                    sprintf( result_str, "%s, Write Multiple Coils [ACK] (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                    sprintf( result_str, "%s, Write Multiple Registers [ACK] (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FUNCCODE_REPORT_SERVER_ID:
-                    sprintf( result_str, "%s, Report Server ID [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_FILE_RECORD:
-                    sprintf( result_str, "%s, Read File Record [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_FILE_RECORD:
-                    sprintf( result_str, "%s, Write File Record [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                    break;
-                case FUNCCODE_MASK_WRITE_REGISTER:
-                    sprintf( result_str, "%s, Mask Write Register [ACK] (%s), RefAddr: %s, And_Mask: %s, OR_Mask: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                    sprintf( result_str, "%s, Read/Write Multiple Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                             ChecksumStr );
-                    break;
-                case FUNCCODE_READ_FIFO_QUEUE:
-                    sprintf( result_str, "%s, Read FIFO Queue [ACK] (%s), ByteCount: %s, FIFO Count: %s", DeviceAddrStr, FunctionCodeStr,
-                             ChecksumStr, Payload2Str );
-                    break;
-                case FUNCCODE_READ_DEVICE_ID:
-                    sprintf( result_str, "%s, Read Device ID (%s), MEI: %s, ReadIDCode: %s, ObjID: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                    break;
-                }
-            }
-            else if( frame.mFlags & FLAG_EXCEPTION_FRAME )
-            {
-                switch( FunctionCode - 0x80 )
-                {
-                case FUNCCODE_READ_COILS:
-                    sprintf( result_str, "%s, Read Coils [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_DISCRETE_INPUTS:
-                    sprintf( result_str, "%s, Read Discrete Inputs [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_HOLDING_REGISTERS:
-                    sprintf( result_str, "%s, Holding Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_INPUT_REGISTER:
-                    sprintf( result_str, "%s, Input Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_SINGLE_COIL:
-                    sprintf( result_str, "%s, Write Single Coil [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_SINGLE_REGISTER:
-                    sprintf( result_str, "%s, Write Single Register [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_EXCEPTION_STATUS:
-                    sprintf( result_str, "%s, Read Exception Status [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_DIAGNOSTIC:
-                    sprintf( result_str, "%s, Diagnostics [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_GET_COM_EVENT_COUNTER:
-                    sprintf( result_str, "%s, Get Comm Event Counter [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_GET_COM_EVENT_LOG:
-                    sprintf( result_str, "%s, Get Comm Event Log [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_COILS:
-                    sprintf( result_str, "%s, Write Multiple Coils [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                    sprintf( result_str, "%s, Write Multiple Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_REPORT_SERVER_ID:
-                    sprintf( result_str, "%s, Report Server ID [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_FILE_RECORD:
-                    sprintf( result_str, "%s, Read File Record [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_WRITE_FILE_RECORD:
-                    sprintf( result_str, "%s, Write File Record [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_MASK_WRITE_REGISTER:
-                    sprintf( result_str, "%s, Mask Write Register [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                    sprintf( result_str, "%s, Read/Write Multiple Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_FIFO_QUEUE:
-                    sprintf( result_str, "%s, Read FIFO Queue [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                case FUNCCODE_READ_DEVICE_ID:
-                    sprintf( result_str, "%s, Read Device ID [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                             Payload1Str, ChecksumStr );
-                    break;
-                default:
-                    sprintf( result_str, "%s, User Defined Function [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                             FunctionCodeStr, Payload1Str, ChecksumStr );
-                    break;
-                }
-            }
-            else if( frame.mFlags & FLAG_FILE_SUBREQ )
-            {
-                sprintf( result_str, ",,SubRequest - RefType: %s, FileNum: %s, RecordNum: %s, RecordLen: %s", FunctionCodeStr, Payload1Str,
-                         Payload2Str, ChecksumStr );
-            }
-            else if( frame.mFlags & FLAG_DATA_FRAME )
-            {
-                sprintf( result_str, ",, Data, Value: %s", Payload1Str );
-            }
-            else if( frame.mFlags & FLAG_END_FRAME )
-            {
-                sprintf( result_str, ",, End of Frame, Checksum: %s", ChecksumStr );
-            }
+    void* f = AnalyzerHelpers::StartFile( file );
 
-            if( frame.mFlags & FLAG_CHECKSUM_ERROR )
-                strcat( result_str, " (Invalid Checksum!)" );
+    const char* counter_columns = "ADUs,Bytes,Requests,Responses,Exceptions,Checksum Errors,Parity Errors,Framing Errors";
 
-            ss << time_str << "," << result_str << std::endl;
+    ss << "DeviceID," << counter_columns << std::endl;
+    for( U32 devaddr = 0; devaddr < 256; devaddr++ )
+    {
+        if( stats.GetDeviceCounters( devaddr ).mAdus == 0 )
+            continue;
 
+        AnalyzerHelpers::GetNumberString( devaddr, display_base, 8, label, 128 );
+        AppendCounters( ss, label, stats.GetDeviceCounters( devaddr ) );
+    }
+    AppendCounters( ss, "Total", stats.GetTotals() );
+    ss << std::endl;
 
-            AnalyzerHelpers::AppendToFile( ( U8* )ss.str().c_str(), ss.str().length(), f );
-            ss.str( std::string() );
+    // exceptions are counted against the function they answer
+    ss << "Function Code," << counter_columns << std::endl;
+    for( U32 funccode = 0; funccode < 128; funccode++ )
+    {
+        if( stats.GetFunctionCounters( funccode ).mAdus == 0 )
+            continue;
 
+        AnalyzerHelpers::GetNumberString( funccode, display_base, 8, label, 128 );
+        AppendCounters( ss, label, stats.GetFunctionCounters( funccode ) );
+    }
+    ss << std::endl;
 
-            if( UpdateExportProgressAndCheckForCancel( i, num_frames ) == true )
-            {
-                AnalyzerHelpers::EndFile( f );
-                return;
-            }
+    ss << "Function Code,Exception Code,Count" << std::endl;
+    for( U32 funccode = 0; funccode < 128; funccode++ )
+    {
+        const ModbusTrafficCounters& counters = stats.GetFunctionCounters( funccode );
+        for( U32 code = 0; code < MODBUS_STATS_EXCEPTION_CODES; code++ )
+        {
+            if( counters.mExceptions[ code ] == 0 )
+                continue;
+
+            char code_str[ 128 ];
+            AnalyzerHelpers::GetNumberString( funccode, display_base, 8, label, 128 );
+            if( code == 0 )
+                strcpy( code_str, "Other" );
+            else
+                AnalyzerHelpers::GetNumberString( code, display_base, 8, code_str, 128 );
+
+            ss << label << "," << code_str << "," << counters.mExceptions[ code ] << std::endl;
         }
     }
-    else
+    ss << std::endl;
+
+    // response times, from the end of a request to the start of its response
+    ss << "DeviceID,Responses,Min [ms],Mean [ms],p50 [ms],p90 [ms],p99 [ms],p99.9 [ms],Max [ms]" << std::endl;
+    for( U32 devaddr = 0; devaddr < 256; devaddr++ )
     {
-        // MP mode.
-        ss << "Time [s],Packet ID,Address,Data,Framing Error" << std::endl;
-        U64 address = 0;
+        const ModbusLatencyHistogram& response_times = stats.GetResponseTimes( devaddr );
+        if( response_times.GetCount() == 0 )
+            continue;
+
+        AnalyzerHelpers::GetNumberString( devaddr, display_base, 8, label, 128 );
+
+        char times_str[ 256 ];
+        sprintf( times_str, "%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f", response_times.GetMin() / 1000.0, response_times.GetMean() / 1000.0,
+                 response_times.GetPercentile( 50.0 ) / 1000.0, response_times.GetPercentile( 90.0 ) / 1000.0,
+                 response_times.GetPercentile( 99.0 ) / 1000.0, response_times.GetPercentile( 99.9 ) / 1000.0,
+                 response_times.GetMax() / 1000.0 );
+
+        ss << label << "," << response_times.GetCount() << "," << times_str << std::endl;
+    }
+    ss << std::endl;
+
+    // requests the client keeps repeating, and how steadily it does
+    ss << "DeviceID,Function Code,Request Fields,Polls,Period [ms],Jitter [ms],Min Interval [ms],Max Interval [ms],Missed Polls"
+       << std::endl;
+    std::vector<const ModbusPollingCycle*> cycles;
+    for( U32 i = 0; i < polling_cycles.GetCycleCount(); i++ )
+        if( polling_cycles.GetCycle( i ).mIntervals > 0 )
+            cycles.push_back( &polling_cycles.GetCycle( i ) );
+    std::sort( cycles.begin(), cycles.end(), PollingCycleComesFirst );
+
+    double ms_per_sample = 1000.0 / sample_rate;
+    for( U32 i = 0; i < cycles.size(); i++ )
+    {
+        const ModbusPollingCycle& cycle = *cycles[ i ];
 
-        for( U32 i = 0; i < num_frames; i++ )
+        AnalyzerHelpers::GetNumberString( cycle.mDevAddr, display_base, 8, label, 128 );
+        char FunctionCodeStr[ 128 ];
+        AnalyzerHelpers::GetNumberString( cycle.mFuncCode, display_base, 8, FunctionCodeStr, 128 );
+
+        std::string fields;
+        for( U32 j = 0; j < cycle.mFieldCount; j++ )
         {
-            Frame frame = GetFrame( i );
+            char field_str[ 128 ];
+            AnalyzerHelpers::GetNumberString( cycle.mFields[ j ], display_base, 8, field_str, 128 );
+            if( j > 0 )
+                fields += " ";
+            fields += field_str;
+        }
 
-            if( ( frame.mFlags & MP_MODE_ADDRESS_FLAG ) != 0 )
-            {
-                address = frame.mData1;
-                continue;
-            }
+        char timing_str[ 256 ];
+        sprintf( timing_str, "%.3f,%.3f,%.3f,%.3f", cycle.mMeanInterval * ms_per_sample,
+                 ModbusPollingCycles::GetJitter( cycle ) * ms_per_sample, cycle.mMinInterval * ms_per_sample,
+                 cycle.mMaxInterval * ms_per_sample );
 
-            U64 packet_id = GetPacketContainingFrameSequential( i );
+        ss << label << "," << FunctionCodeStr << "," << fields << "," << cycle.mPolls << "," << timing_str << "," << cycle.mMissedPolls
+           << std::endl;
+    }
+    ss << std::endl;
 
-            // static void GetTimeString( U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32
-            // result_string_max_length );
-            char time_str[ 128 ];
-            AnalyzerHelpers::GetTimeString( frame.mStartingSampleInclusive, trigger_sample, sample_rate, time_str, 128 );
+    // averaged over both lines in full duplex modes
+    ss << "Time [s],Bus Utilization [%]" << std::endl;
+    U32 bucket_count = stats.GetUtilizationBucketCount();
+    U64 bucket_width = stats.GetUtilizationBucketWidth();
+    for( U32 i = 0; i < bucket_count; i++ )
+    {
+        char time_str[ 128 ];
+        AnalyzerHelpers::GetTimeString( i * bucket_width, 0, sample_rate, time_str, 128 );
 
-            char address_str[ 128 ];
-            AnalyzerHelpers::GetNumberString( address, display_base, mSettings->mBitsPerTransfer - 1, address_str, 128 );
+        char utilization_str[ 32 ];
+        sprintf( utilization_str, "%.2f", stats.GetUtilization( i ) * 100.0 );
 
-            char number_str[ 128 ];
-            AnalyzerHelpers::GetNumberString( frame.mData1, display_base, mSettings->mBitsPerTransfer - 1, number_str, 128 );
-            if( packet_id == INVALID_RESULT_INDEX )
-                ss << time_str << ","
-                   << ""
-                   << "," << address_str << "," << number_str << ",";
-            else
-                ss << time_str << "," << packet_id << "," << address_str << "," << number_str << ",";
+        ss << time_str << "," << utilization_str << std::endl;
+    }
 
-            if( ( frame.mFlags & FRAMING_ERROR_FLAG ) != 0 )
-                ss << "Error";
+    AnalyzerHelpers::AppendToFile( ( U8* )ss.str().c_str(), ss.str().length(), f );
 
-            ss << std::endl;
+    UpdateExportProgressAndCheckForCancel( 1, 1 );
+    AnalyzerHelpers::EndFile( f );
+}
 
-            AnalyzerHelpers::AppendToFile( ( U8* )ss.str().c_str(), ss.str().length(), f );
-            ss.str( std::string() );
+void ModbusAnalyzerResults::AppendCounters( std::stringstream& ss, const char* label, const ModbusTrafficCounters& counters )
+{
+    U64 exceptions = 0;
+    for( U32 code = 0; code < MODBUS_STATS_EXCEPTION_CODES; code++ )
+        exceptions += counters.mExceptions[ code ];
 
+    ss << label << "," << counters.mAdus << "," << counters.mBytes << "," << counters.mRequests << "," << counters.mResponses << ","
+       << exceptions << "," << counters.mChecksumErrors << "," << counters.mParityErrors << "," << counters.mFramingErrors << std::endl;
+}
 
-            if( UpdateExportProgressAndCheckForCancel( i, num_frames ) == true )
-            {
-                AnalyzerHelpers::EndFile( f );
-                return;
-            }
+void ModbusAnalyzerResults::GenerateBinaryFile( const char* file )
+{
+    // see ModbusBinaryExport.h for the layout
+    U64 num_frames = GetNumFrames();
+    bool modbus_mode = mSettings->mModbusMode != ModbusAnalyzerEnums::Normal &&
+                       mSettings->mModbusMode != ModbusAnalyzerEnums::MpModeMsbZeroMeansAddress &&
+                       mSettings->mModbusMode != ModbusAnalyzerEnums::MpModeMsbOneMeansAddress;
+
+    ModbusExportWriter writer( file );
+    U64 offset = 0;
+
+    U8 header[ MODBUS_BINARY_HEADER_SIZE ] = {};
+    memcpy( header, "MBADUBIN", 8 );
+    ModbusPutU32( header + 8, MODBUS_BINARY_VERSION );
+    ModbusPutU32( header + 12, MODBUS_BINARY_RECORD_SIZE );
+    ModbusPutU64( header + 16, mAnalyzer->GetSampleRate() );
+    ModbusPutU64( header + 24, mAnalyzer->GetTriggerSample() );
+    writer.Append( ( const char* )header, sizeof( header ) );
+    offset += sizeof( header );
+
+    // the payloads only go out once all the records have, so they are gathered up here as each record goes out
+    U64 records_offset = offset;
+    std::vector<U8> payloads;
+    std::vector<U64> time_index;
+    std::vector<U64> device_records[ 256 ];
+
+    for( U64 i = 0; i < num_frames; i++ )
+    {
+        Frame frame = GetFrame( i );
+
+        // every ADU, whether its frame kept a payload or was put back together from its fields; outside the Modbus modes, none
+        U8 adu[ MODBUS_MAX_ADU_SIZE ];
+        U32 adu_length = modbus_mode ? GetAduBytes( i, frame, adu ) : 0;
+
+        U8 devaddr = modbus_mode ? U8( frame.mData1 >> 56 ) : 0;
+        U8 funccode = modbus_mode ? U8( frame.mData1 >> 48 ) : 0;
+
+        U8 record[ MODBUS_BINARY_RECORD_SIZE ];
+        ModbusPutU64( record + 0, frame.mStartingSampleInclusive );
+        ModbusPutU64( record + 8, frame.mEndingSampleInclusive );
+        ModbusPutU64( record + 16, frame.mData1 );
+        ModbusPutU64( record + 24, frame.mData2 );
+        ModbusPutU64( record + 32, payloads.size() );
+        ModbusPutU32( record + 40, adu_length );
+        record[ 44 ] = devaddr;
+        record[ 45 ] = funccode;
+        record[ 46 ] = frame.mFlags;
+        record[ 47 ] = frame.mType;
+        writer.Append( ( const char* )record, sizeof( record ) );
+
+        payloads.insert( payloads.end(), adu, adu + adu_length );
+        if( i % MODBUS_BINARY_TIME_INDEX_STRIDE == 0 )
+        {
+            time_index.push_back( frame.mStartingSampleInclusive );
+            time_index.push_back( i );
         }
+        device_records[ devaddr ].push_back( i );
+
+        if( i % MODBUS_EXPORT_PROGRESS_LINES == 0 && UpdateExportProgressAndCheckForCancel( i, num_frames ) == true )
+            return;
     }
+    offset += num_frames * MODBUS_BINARY_RECORD_SIZE;
 
+    U64 payloads_offset = offset;
+    U64 payloads_size = payloads.size();
+    if( payloads_size > 0 )
+        writer.Append( ( const char* )&payloads[ 0 ], U32( payloads_size ) );
+
+    U8 padding[ 8 ] = {};
+    U32 padding_length = U32( ( 8 - payloads_size % 8 ) % 8 );
+    writer.Append( ( const char* )padding, padding_length );
+    offset += payloads_size + padding_length;
+
+    U64 time_index_offset = offset;
+    for( U32 i = 0; i < time_index.size(); i++ )
+    {
+        U8 value[ 8 ];
+        ModbusPutU64( value, time_index[ i ] );
+        writer.Append( ( const char* )value, sizeof( value ) );
+    }
+    offset += time_index.size() * 8;
+
+    U64 device_index_offset = offset;
+    U64 first = 0;
+    for( U32 devaddr = 0; devaddr < 256; devaddr++ )
+    {
+        U8 entry[ 16 ];
+        ModbusPutU64( entry, first );
+        ModbusPutU64( entry + 8, device_records[ devaddr ].size() );
+        writer.Append( ( const char* )entry, sizeof( entry ) );
+        first += device_records[ devaddr ].size();
+    }
+    for( U32 devaddr = 0; devaddr < 256; devaddr++ )
+    {
+        for( U64 i = 0; i < device_records[ devaddr ].size(); i++ )
+        {
+            U8 value[ 8 ];
+            ModbusPutU64( value, device_records[ devaddr ][ i ] );
+            writer.Append( ( const char* )value, sizeof( value ) );
+        }
+    }
+
+    U8 trailer[ MODBUS_BINARY_TRAILER_SIZE ];
+    ModbusPutU64( trailer + 0, records_offset );
+    ModbusPutU64( trailer + 8, num_frames );
+    ModbusPutU64( trailer + 16, payloads_offset );
+    ModbusPutU64( trailer + 24, payloads_size );
+    ModbusPutU64( trailer + 32, time_index_offset );
+    ModbusPutU64( trailer + 40, time_index.size() / 2 );
+    ModbusPutU64( trailer + 48, device_index_offset );
+    memcpy( trailer + 56, "MBADUEND", 8 );
+    writer.Append( ( const char* )trailer, sizeof( trailer ) );
+
+    writer.Close();
+    UpdateExportProgressAndCheckForCancel( num_frames, num_frames );
+}
+
+void ModbusAnalyzerResults::GeneratePcapngFile( const char* file )
+{
+    // see ModbusPcapngExport.h for what goes in the packets
+    U64 num_frames = GetNumFrames();
+    U64 sample_rate = mAnalyzer->GetSampleRate();
+    bool modbus_mode = mSettings->mModbusMode != ModbusAnalyzerEnums::Normal &&
+                       mSettings->mModbusMode != ModbusAnalyzerEnums::MpModeMsbZeroMeansAddress &&
+                       mSettings->mModbusMode != ModbusAnalyzerEnums::MpModeMsbOneMeansAddress;
+
+    ModbusExportWriter writer( file );
+
+    U8 section_header[ 28 ];
+    ModbusPutU32( section_header + 0, PCAPNG_BLOCK_SECTION_HEADER );
+    ModbusPutU32( section_header + 4, sizeof( section_header ) );
+    ModbusPutU32( section_header + 8, PCAPNG_BYTE_ORDER_MAGIC );
+    ModbusPutU16( section_header + 12, 1 );
+    ModbusPutU16( section_header + 14, 0 );
+    ModbusPutU64( section_header + 16, 0xFFFFFFFFFFFFFFFFull ); // section length not given
+    ModbusPutU32( section_header + 24, sizeof( section_header ) );
+    writer.Append( ( const char* )section_header, sizeof( section_header ) );
+
+    U8 interface[ 32 ] = {};
+    ModbusPutU32( interface + 0, PCAPNG_BLOCK_INTERFACE_DESCRIPTION );
+    ModbusPutU32( interface + 4, sizeof( interface ) );
+    ModbusPutU16( interface + 8, PCAPNG_LINKTYPE_USER0 );
+    ModbusPutU32( interface + 12, MODBUS_MAX_ADU_SIZE );
+    ModbusPutU16( interface + 16, PCAPNG_OPTION_IF_TSRESOL );
+    ModbusPutU16( interface + 18, 1 );
+    interface[ 20 ] = 9; // nanoseconds
+    ModbusPutU16( interface + 24, PCAPNG_OPTION_END );
+    ModbusPutU16( interface + 26, 0 );
+    ModbusPutU32( interface + 28, sizeof( interface ) );
+    writer.Append( ( const char* )interface, sizeof( interface ) );
+
+    // outside the Modbus modes there are no ADUs, just the empty interface
+    if( !modbus_mode )
+        num_frames = 0;
+
+    for( U64 i = 0; i < num_frames; i++ )
+    {
+        Frame frame = GetFrame( i );
+
+        U8 packet[ 28 + MODBUS_MAX_ADU_SIZE + 3 + 16 ] = {};
+        U32 adu_length = GetAduBytes( i, frame, packet + 28 );
+        U32 padded_length = ( adu_length + 3 ) & ~3U;
+        U32 block_length = 28 + padded_length + 12 + 4;
+
+        // split so as not to overflow on long captures at high sample rates
+        U64 sample = frame.mStartingSampleInclusive;
+        U64 timestamp = ( sample / sample_rate ) * 1000000000ull + ( sample % sample_rate ) * 1000000000ull / sample_rate;
+
+        ModbusPutU32( packet + 0, PCAPNG_BLOCK_ENHANCED_PACKET );
+        ModbusPutU32( packet + 4, block_length );
+        ModbusPutU32( packet + 8, 0 ); // interface
+        ModbusPutU32( packet + 12, U32( timestamp >> 32 ) );
+        ModbusPutU32( packet + 16, U32( timestamp ) );
+        ModbusPutU32( packet + 20, adu_length );
+        ModbusPutU32( packet + 24, adu_length );
+
+        U8* options = packet + 28 + padded_length;
+        bool request = ( frame.mFlags & FLAG_REQUEST_FRAME ) != 0;
+        ModbusPutU16( options + 0, PCAPNG_OPTION_EPB_FLAGS );
+        ModbusPutU16( options + 2, 4 );
+        ModbusPutU32( options + 4, request ? PCAPNG_EPB_FLAGS_OUTBOUND : PCAPNG_EPB_FLAGS_INBOUND );
+        ModbusPutU16( options + 8, PCAPNG_OPTION_END );
+        ModbusPutU16( options + 10, 0 );
+        ModbusPutU32( options + 12, block_length );
+
+        writer.Append( ( const char* )packet, block_length );
+
+        if( i % MODBUS_EXPORT_PROGRESS_LINES == 0 && UpdateExportProgressAndCheckForCancel( i, num_frames ) == true )
+            return;
+    }
+
+    writer.Close();
+    UpdateExportProgressAndCheckForCancel( num_frames, num_frames );
+}
+
+void ModbusAnalyzerResults::GenerateColumnsFile( const char* file )
+{
+    U64 trigger_sample = mAnalyzer->GetTriggerSample();
+    U32 sample_rate = mAnalyzer->GetSampleRate();
+    U64 num_frames = GetNumFrames();
+    bool modbus_mode = mSettings->mModbusMode != ModbusAnalyzerEnums::Normal &&
+                       mSettings->mModbusMode != ModbusAnalyzerEnums::MpModeMsbZeroMeansAddress &&
+                       mSettings->mModbusMode != ModbusAnalyzerEnums::MpModeMsbOneMeansAddress;
+
+    ModbusExportWriter writer( file );
+    // meant for spreadsheets and scripts, so the numbers are in decimal whatever the display base, and the header says so
+    writer.Append( "Time [s],Direction,DeviceID [dec],Function Code [dec],Start Address [dec],Quantity [dec],Byte Count [dec],"
+                   "Exception Code [dec],CRC OK,Payload [hex]\n" );
+
+    // outside the Modbus modes there are no ADUs to break down
+    if( !modbus_mode )
+        num_frames = 0;
+
+    ModbusFrameFormatter formatter( Decimal, 16 );
+
+    // a field that isn't there leaves its column empty
+    ModbusExportWriter::FrameFetcher fetch_frame = [&]( U64 i ) { return GetFrame( i ); };
+
+    ModbusExportWriter::LineFormatter format_line = [&]( U64 i, const Frame& frame, ModbusTextBuffer& line ) {
+        ModbusFrameFormatter::AppendTime( line, frame.mStartingSampleInclusive, trigger_sample, sample_rate );
+
+        line.Append( ( frame.mFlags & FLAG_REQUEST_FRAME ) ? ",Request," : ",Response," );
+        formatter.AppendNumber( line, frame.mData1 >> 56 );
+        line.Append( "," );
+        formatter.AppendNumber( line, ( frame.mData1 >> 48 ) & 0xFF );
+
+        S32 values[ ColumnCount ];
+        formatter.GetColumnValues( frame, values );
+        for( U32 column = ColumnStartAddress; column < ColumnCount; column++ )
+        {
+            line.Append( "," );
+            if( values[ column ] >= 0 )
+                formatter.AppendNumber( line, values[ column ] );
+        }
+
+        line.Append( ( frame.mFlags & FLAG_CHECKSUM_ERROR ) ? ",0," : ",1," );
+
+        // the ADU as it went over the line, two hex digits a byte
+        U8 adu[ MODBUS_MAX_ADU_SIZE ];
+        U32 adu_length = GetAduBytes( i, frame, adu );
+        char hex[ MODBUS_MAX_ADU_SIZE * 2 ];
+        for( U32 b = 0; b < adu_length; b++ )
+        {
+            hex[ b * 2 ] = "0123456789ABCDEF"[ adu[ b ] >> 4 ];
+            hex[ b * 2 + 1 ] = "0123456789ABCDEF"[ adu[ b ] & 0xF ];
+        }
+        line.Append( hex, adu_length * 2 );
+
+        line.Append( "\n" );
+    };
+
+    ModbusExportWriter::ProgressCallback progress = [&]( U64 lines_written ) {
+        return UpdateExportProgressAndCheckForCancel( lines_written, num_frames );
+    };
+
+    if( !writer.WriteLines( num_frames, 1024 + MODBUS_MAX_ADU_SIZE * 2, fetch_frame, format_line, progress, formatter.IsReentrant() ) )
+        return;
+
+    writer.Close();
     UpdateExportProgressAndCheckForCancel( num_frames, num_frames );
-    AnalyzerHelpers::EndFile( f );
 }
 
 void ModbusAnalyzerResults::GenerateFrameTabularText( U64 frame_index, DisplayBase display_base )
+{
+    ModbusStringCache::Strings strings = mStringCache.Find( frame_index, display_base, ModbusStringCache::FrameTabular );
+    if( strings )
+    {
+        AnalyzerResults::ClearTabularText();
+        for( U32 i = 0; i < strings->size(); i++ )
+            AnalyzerResults::AddTabularText( ( *strings )[ i ].c_str() );
+        return;
+    }
+
+    FormatFrameTabularText( frame_index, display_base );
+    mStringCache.Add( frame_index, display_base, ModbusStringCache::FrameTabular, mTabularStrings );
+}
+
+void ModbusAnalyzerResults::FormatFrameTabularText( U64 frame_index, DisplayBase display_base )
 {
     Frame frame = GetFrame( frame_index );
     ClearTabularText();
@@ -1229,446 +793,19 @@ void ModbusAnalyzerResults::GenerateFrameTabularText( U64 frame_index, DisplayBa
 
     if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
         mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer ||
-        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex ||
+        mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
     {
-        char DeviceAddrStr[ 128 ];
-        U8 DeviceAddr = ( frame.mData1 & 0xFF00000000000000 ) >> 56;
-        AnalyzerHelpers::GetNumberString( DeviceAddr, display_base, bits_per_transfer, DeviceAddrStr, 128 );
-
-        char FunctionCodeStr[ 128 ];
-        U8 FunctionCode = ( frame.mData1 & 0x00FF000000000000 ) >> 48;
-        AnalyzerHelpers::GetNumberString( FunctionCode, display_base, bits_per_transfer, FunctionCodeStr, 128 );
-
-        char Payload1Str[ 128 ];
-        U16 Payload1 = ( frame.mData1 & 0x0000FFFF00000000 ) >> 32;
-        AnalyzerHelpers::GetNumberString( Payload1, display_base, bits_per_transfer, Payload1Str, 128 );
-
-        char Payload2Str[ 128 ];
-        U16 Payload2 = ( frame.mData1 & 0x00000000FFFF0000 ) >> 16;
-        AnalyzerHelpers::GetNumberString( Payload2, display_base, bits_per_transfer, Payload2Str, 128 );
-
-        char Payload3Str[ 128 ];
-        U16 Payload3 = ( frame.mData2 & 0x000000000000FFFF );
-        AnalyzerHelpers::GetNumberString( Payload3, display_base, bits_per_transfer, Payload3Str, 128 );
-
-        char Payload4Str[ 128 ];
-        U16 Payload4 = ( frame.mData2 & 0x00000000FFFF0000 ) >> 16;
-        AnalyzerHelpers::GetNumberString( Payload4, display_base, bits_per_transfer, Payload4Str, 128 );
-
-        char ChecksumStr[ 128 ];
-        U16 Checksum = ( frame.mData1 & 0x000000000000FFFF );
-        AnalyzerHelpers::GetNumberString( Checksum, display_base, bits_per_transfer, ChecksumStr, 128 );
-
-        char result_str[ 256 ] = { '\0' };
-        char Error_str[ 128 ] = { '\0' };
-
-        if( frame.mFlags & FLAG_REQUEST_FRAME )
-        {
-            switch( FunctionCode )
-            {
-            case FUNCCODE_READ_COILS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Coils (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DISCRETE_INPUTS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Discrete Inputs (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_HOLDING_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Holding Registers (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_INPUT_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Input Registers (%s), StartAddr: %s, Qty: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_COIL:
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Coil (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Register (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_EXCEPTION_STATUS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Exception Status (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_DIAGNOSTIC:
-
-                switch( Payload1 )
-                {
-                case RETURN_QUERY_DATA:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Return Query Data (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RESTART_COMMUNICATIONS_OPTION:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Restart Comms Option (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_DIAGNOSTIC_REGISTER:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Return Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CHANGE_ASCII_INPUT_DELIM:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Change ASCII Input Delim (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FORCE_LISTEN_ONLY_MODE:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Force Listen Only Mode (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_COUNTERS_AND_DIAG_REGISTER:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Clr Counters And Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_MESSAGE_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_COMM_ERROR_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Comm Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Excpt Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_MESSAGE_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NO_RESPONSE_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server No Resp Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NAK_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server NAK Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_BUSY_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Server Busy Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_CHAR_OVERRUN_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Bus Char Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics (%s), SubFunc: Clear Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                }
-                break;
-            case FUNCCODE_GET_COM_EVENT_COUNTER:
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Counter (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_LOG:
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Log (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_COILS:
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Coils (%s), StartAddr: %s, Qty: %s, ByteCount: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Registers (%s), StartAddr: %s, Qty: %s, ByteCount: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_REPORT_SERVER_ID:
-                sprintf( result_str, "DeviceID: %s, Func: Report Server ID (%s), ChkSum: %s", DeviceAddrStr, FunctionCodeStr, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FILE_RECORD:
-                sprintf( result_str, "DeviceID: %s, Func: Read File Record (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_FILE_RECORD:
-                AddTabularText( "Write File Record" );
-                sprintf( result_str, "DeviceID: %s, Func: Write File Record (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_MASK_WRITE_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Mask Write Register (%s), RefAddr: %s, And_Mask: %s, OR_Mask: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                sprintf( result_str,
-                         "DeviceID: %s, Func: Read/Write Multiple Registers (%s), ReadStartAddr: %s, ReadQty: %s, WriteStartAddr: %s, "
-                         "WriteQty: %s, ByteCount: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload4Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FIFO_QUEUE:
-                sprintf( result_str, "DeviceID: %s, Func: Read FIFO Queue (%s), Addr: %s, ChkSum: %s", DeviceAddrStr, FunctionCodeStr,
-                         Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DEVICE_ID:
-                sprintf( result_str, "DeviceID: %s, Func: Read Device ID (%s), MEI: %s, ReadIDCode: %s, ObjID: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            }
-        }
-        else if( frame.mFlags & FLAG_RESPONSE_FRAME )
-        {
-            switch( FunctionCode )
-            {
-            case FUNCCODE_READ_COILS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Coils [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_DISCRETE_INPUTS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Discrete Inputs [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_HOLDING_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Holding Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_INPUT_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Input Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_COIL:
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Coil [ACK] (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Register [ACK] (%s), Addr: %s, Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_EXCEPTION_STATUS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Exception Status [ACK] (%s), Value: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_DIAGNOSTIC:
-
-                switch( Payload1 )
-                {
-                case RETURN_QUERY_DATA:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Return Query Data (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RESTART_COMMUNICATIONS_OPTION:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Restart Comms Option (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_DIAGNOSTIC_REGISTER:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Return Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CHANGE_ASCII_INPUT_DELIM:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Change ASCII Input Delim (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case FORCE_LISTEN_ONLY_MODE:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Force Listen Only Mode (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_COUNTERS_AND_DIAG_REGISTER:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Clr Counters And Diag Reg (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_MESSAGE_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_COMM_ERROR_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Comm Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Excpt Err Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_MESSAGE_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server Msg Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NO_RESPONSE_COUNT:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server No Resp Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_NAK_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server NAK Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_SERVER_BUSY_COUNT:
-                    sprintf( result_str, "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Server Busy Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case RETURN_BUS_CHAR_OVERRUN_COUNT:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Bus Char Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                case CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                    sprintf( result_str,
-                             "DeviceID: %s, Func: Diagnostics [ACK] (%s), SubFunc: Clear Overrun Cnt (%s), Data: %s, ChkSum: %s",
-                             DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                    break;
-                }
-                break;
-            case FUNCCODE_GET_COM_EVENT_COUNTER:
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Counter [ACK] (%s), Status: %s, Count: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_LOG:
-                sprintf( result_str,
-                         "DeviceID: %s, Func: Get Comm Event Log [ACK] (%s), Status: %s, EventCnt: %s, MsgCnt: %s, ByteCount: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload4Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_COILS:
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Coils [ACK] (%s), StartAddr: %s, Qty: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Registers [ACK] (%s), StartAddr: %s, Qty: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, ChecksumStr );
-                break;
-            case FUNCCODE_REPORT_SERVER_ID:
-                sprintf( result_str, "DeviceID: %s, Func: Report Server ID [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_READ_FILE_RECORD:
-                sprintf( result_str, "DeviceID: %s, Func: Read File Record [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_FILE_RECORD:
-                sprintf( result_str, "DeviceID: %s, Func: Write File Record [ACK] (%s), ByteCount: %s", DeviceAddrStr, FunctionCodeStr,
-                         ChecksumStr );
-                break;
-            case FUNCCODE_MASK_WRITE_REGISTER:
-                sprintf( result_str,
-                         "DeviceID: %s, Func: Mask Write Register [ACK] (%s), RefAddr: %s, And_Mask: %s, OR_Mask: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Read/Write Multiple Registers [ACK] (%s), ByteCount: %s", DeviceAddrStr,
-                         FunctionCodeStr, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FIFO_QUEUE:
-                sprintf( result_str, "DeviceID: %s, Func: Read FIFO Queue [ACK] (%s), ByteCount: %s, FIFO Count: %s", DeviceAddrStr,
-                         FunctionCodeStr, ChecksumStr, Payload2Str );
-                break;
-            case FUNCCODE_READ_DEVICE_ID:
-                sprintf( result_str, "DeviceID: %s, Func: Read Device ID (%s), MEI: %s, ReadIDCode: %s, ObjID: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, Payload2Str, Payload3Str, ChecksumStr );
-                break;
-            }
-        }
-        else if( frame.mFlags & FLAG_EXCEPTION_FRAME )
-        {
-            switch( FunctionCode - 0x80 )
-            {
-            case FUNCCODE_READ_COILS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Coils [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DISCRETE_INPUTS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Discrete Inputs [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_HOLDING_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Holding Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_INPUT_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Input Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_COIL:
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Coil [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_SINGLE_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Write Single Register [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_EXCEPTION_STATUS:
-                sprintf( result_str, "DeviceID: %s, Func: Read Exception Status [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_DIAGNOSTIC:
-                sprintf( result_str, "DeviceID: %s, Func: Diagnostics [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_COUNTER:
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Counter [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_GET_COM_EVENT_LOG:
-                sprintf( result_str, "DeviceID: %s, Func: Get Comm Event Log [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_COILS:
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Coils [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_MULTIPLE_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Write Multiple Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_REPORT_SERVER_ID:
-                sprintf( result_str, "DeviceID: %s, Func: Report Server ID [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FILE_RECORD:
-                sprintf( result_str, "DeviceID: %s, Func: Read File Record [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_WRITE_FILE_RECORD:
-                sprintf( result_str, "DeviceID: %s, Func: Write File Record [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_MASK_WRITE_REGISTER:
-                sprintf( result_str, "DeviceID: %s, Func: Mask Write Register [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READWRITE_MULTIPLE_REGISTERS:
-                sprintf( result_str, "DeviceID: %s, Func: Read/Write Multiple Registers [NACK] (%s), ExceptionCode: %s, ChkSum: %s",
-                         DeviceAddrStr, FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_FIFO_QUEUE:
-                sprintf( result_str, "DeviceID: %s, Func: Read FIFO Queue [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            case FUNCCODE_READ_DEVICE_ID:
-                sprintf( result_str, "DeviceID: %s, Func: Read Device ID [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            default:
-                sprintf( result_str, "DeviceID: %s, Func: User Defined Function [NACK] (%s), ExceptionCode: %s, ChkSum: %s", DeviceAddrStr,
-                         FunctionCodeStr, Payload1Str, ChecksumStr );
-                break;
-            }
-        }
-        else if( frame.mFlags & FLAG_FILE_SUBREQ )
-        {
-            sprintf( result_str, "SubRequest - RefType: %s, FileNum: %s, RecordNum: %s, RecordLen: %s", FunctionCodeStr, Payload1Str,
-                     Payload2Str, ChecksumStr );
-        }
-        else if( frame.mFlags & FLAG_DATA_FRAME )
-        {
-            sprintf( result_str, "Value: %s", Payload1Str );
-        }
-        else if( frame.mFlags & FLAG_END_FRAME )
-        {
-            sprintf( result_str, " Checksum: %s", ChecksumStr );
-        }
-
-        if( frame.mFlags & FLAG_CHECKSUM_ERROR )
-            strcat( result_str, " (Invalid Checksum!)" );
+        ModbusFrameFormatter formatter( display_base, bits_per_transfer );
+        char text_str[ MODBUS_TEXT_SIZE ];
+        ModbusTextBuffer text( text_str, sizeof( text_str ) );
 
-        AddTabularText( result_str );
+        // the data table has room for more of the body than a bubble
+        AppendFrameText( text, frame_index, frame, formatter, true, 32 );
+        AddTabularText( text.GetText() );
     }
     else
     {
@@ -1715,16 +852,332 @@ void ModbusAnalyzerResults::GenerateFrameTabularText( U64 frame_index, DisplayBa
     }
 }
 
-void ModbusAnalyzerResults::GeneratePacketTabularText( U64 /*packet_id*/,
-                                                       DisplayBase /*display_base*/ ) // unrefereced vars commented out to remove warnings.
+void ModbusAnalyzerResults::AddPayload( U64 frame_index, const U8* data, U32 length )
+{
+    mPayloads.Add( frame_index, data, length );
+}
+
+U32 ModbusAnalyzerResults::GetPayload( U64 frame_index, const U8*& data ) const
+{
+    return mPayloads.Get( frame_index, data );
+}
+
+U32 ModbusAnalyzerResults::GetAduBytes( U64 frame_index, const Frame& frame, U8* adu ) const
+{
+    // frames with a body have the whole ADU in their payload
+    const U8* payload;
+    U32 length = GetPayload( frame_index, payload );
+    if( length != 0 )
+    {
+        memcpy( adu, payload, length );
+        return length;
+    }
+
+    // the rest are put back together from their fields
+    U8 funccode = ( frame.mData1 >> 48 ) & 0xFF;
+    adu[ length++ ] = U8( frame.mData1 >> 56 );
+    adu[ length++ ] = funccode;
+
+    // how far a truncated ADU got isn't kept
+    if( frame.mFlags & FLAG_TRUNCATED_FRAME )
+        return length;
+
+    const ModbusPduLayout& layout = GetModbusPduLayout( funccode, ( frame.mFlags & FLAG_REQUEST_FRAME ) == 0 );
+    for( U32 i = 0; i < layout.mFieldCount; i++ )
+    {
+        U16 value = ModbusFrameFormatter::GetSlotValue( frame, layout.mFields[ i ].mSlot );
+        if( layout.mFields[ i ].mSize == 2 )
+            adu[ length++ ] = U8( value >> 8 );
+        adu[ length++ ] = U8( value );
+    }
+
+    // RTU sends the CRC low byte first; ASCII has a single LRC byte
+    U16 checksum = frame.mData1 & 0xFFFF;
+    adu[ length++ ] = U8( checksum );
+    if( !mSettings->IsAsciiMode() )
+        adu[ length++ ] = U8( checksum >> 8 );
+
+    return length;
+}
+
+void ModbusAnalyzerResults::IndexFrame( U64 frame_index, const Frame& frame, bool line_errors )
+{
+    U32 errors = 0;
+    if( frame.mFlags & FLAG_EXCEPTION_FRAME )
+        errors |= ModbusFrameIndexEnums::ErrorException;
+    if( frame.mFlags & FLAG_TRUNCATED_FRAME )
+        errors |= ModbusFrameIndexEnums::ErrorTruncated;
+    else if( frame.mFlags & FLAG_CHECKSUM_ERROR )
+        errors |= ModbusFrameIndexEnums::ErrorChecksum;
+    if( line_errors )
+        errors |= ModbusFrameIndexEnums::ErrorLine;
+
+    mFrameIndex.Add( frame_index, U8( frame.mData1 >> 56 ), U8( frame.mData1 >> 48 ), errors );
+}
+
+void ModbusAnalyzerResults::FindFrames( const ModbusFrameQuery& query, std::vector<U64>& frame_indexes )
+{
+    U64 first_frame;
+    U64 end_frame;
+    FindFrameRange( query, first_frame, end_frame );
+    mFrameIndex.Find( query, first_frame, end_frame, frame_indexes );
+}
+
+void ModbusAnalyzerResults::FindFrameRange( const ModbusFrameQuery& query, U64& first_frame, U64& end_frame )
+{
+    // frames are added in time order, so each end of the range is a binary search on start samples, in the exports' own seconds
+    U64 trigger_sample = mAnalyzer->GetTriggerSample();
+    double sample_rate = mAnalyzer->GetSampleRate();
+
+    U64 low = 0;
+    U64 high = GetNumFrames();
+    while( low < high )
+    {
+        U64 middle = low + ( high - low ) / 2;
+        double time = double( S64( GetFrame( middle ).mStartingSampleInclusive - trigger_sample ) ) / sample_rate;
+        if( time < query.mFromTime )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    first_frame = low;
+
+    high = GetNumFrames();
+    while( low < high )
+    {
+        U64 middle = low + ( high - low ) / 2;
+        double time = double( S64( GetFrame( middle ).mStartingSampleInclusive - trigger_sample ) ) / sample_rate;
+        if( time <= query.mToTime )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    end_frame = low;
+}
+
+void ModbusAnalyzerResults::GetExportFilter( ModbusFrameQuery& query ) const
+{
+    // checked when the settings were applied; should it fail anyway, every frame goes out
+    std::string query_error;
+    if( !ParseModbusFrameQuery( mSettings->mExportFilter.c_str(), query, query_error ) )
+        query = ModbusFrameQuery();
+}
+
+void ModbusAnalyzerResults::ClearResultStrings()
+{
+    AnalyzerResults::ClearResultStrings();
+    mBubbleStrings.clear();
+}
+
+void ModbusAnalyzerResults::AddResultString( const char* str )
+{
+    AnalyzerResults::AddResultString( str );
+    mBubbleStrings.push_back( str );
+}
+
+void ModbusAnalyzerResults::ClearTabularText()
+{
+    AnalyzerResults::ClearTabularText();
+    mTabularStrings.clear();
+}
+
+void ModbusAnalyzerResults::AddTabularText( const char* str )
+{
+    AnalyzerResults::AddTabularText( str );
+    mTabularStrings.push_back( str );
+}
+
+void ModbusAnalyzerResults::AppendFrameText( ModbusTextBuffer& text, U64 frame_index, const Frame& frame,
+                                             const ModbusFrameFormatter& formatter, bool labels, U32 max_values )
+{
+    formatter.AppendFields( text, frame, labels );
+    AppendPduBody( text, frame_index, frame, formatter, max_values );
+
+    if( frame.mFlags & FLAG_TRUNCATED_FRAME )
+        text.Append( " (Truncated Frame!)" );
+    else if( frame.mFlags & FLAG_CHECKSUM_ERROR )
+        text.Append( " (Invalid Checksum!)" );
+
+    if( frame.mFlags & FRAMING_ERROR_FLAG )
+        text.Append( " (No t3.5 Gap!)" );
+
+    if( frame.mFlags & FLAG_OVERLAPPING_FRAME )
+        text.Append( " (Overlaps Other Line)" );
+}
+
+void ModbusAnalyzerResults::AppendPduBody( ModbusTextBuffer& text, U64 frame_index, const Frame& frame,
+                                           const ModbusFrameFormatter& formatter, U32 max_values )
+{
+    // Only frames of ADUs with a body have a payload: the whole ADU, address to checksum. The fixed fields are already in the frame
+    // (and so in the text); what's left to show is the body and the checksum.
+    const U8* adu;
+    U32 adu_length = GetPayload( frame_index, adu );
+    if( adu_length < 2 )
+        return;
+
+    bool response = ( frame.mFlags & FLAG_REQUEST_FRAME ) == 0;
+    const ModbusPduLayout& layout = GetModbusPduLayout( adu[ 1 ], response );
+
+    // a truncated ADU never got to its checksum
+    bool ascii_mode = mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient ||
+                      mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer ||
+                      mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex ||
+                      mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex;
+    U32 checksum_size = ascii_mode ? 1 : 2;
+    bool has_checksum = ( frame.mFlags & FLAG_TRUNCATED_FRAME ) == 0 && adu_length >= 2 + checksum_size;
+    U32 pdu_end = has_checksum ? adu_length - checksum_size : adu_length;
+
+    U32 index = 2;
+    AppendPduItems( text, layout, false, adu, pdu_end, index, formatter, max_values );
+
+    if( has_checksum )
+    {
+        U16 checksum = ascii_mode ? adu[ pdu_end ] : adu[ pdu_end ] | ( adu[ pdu_end + 1 ] << 8 );
+        text.Append( ", ChkSum: " );
+        formatter.AppendNumber( text, checksum, 8 * checksum_size );
+    }
+}
+
+void ModbusAnalyzerResults::AppendPduItems( ModbusTextBuffer& text, const ModbusPduLayout& layout, bool show_fields, const U8* adu,
+                                            U32 pdu_end, U32& index, const ModbusFrameFormatter& formatter, U32& values_left )
+{
+    // the same walk as ModbusAnalyzer::ParsePdu(), over the stored bytes
+    S64 length = -1;
+
+    if( show_fields )
+        text.Append( ", SubRequest -" );
+
+    for( U32 i = 0; i < layout.mFieldCount && index < pdu_end; i++ )
+    {
+        const ModbusPduField& field = layout.mFields[ i ];
+        U32 value = adu[ index++ ];
+        if( field.mSize == 2 && index < pdu_end )
+            value = ( value << 8 ) | adu[ index++ ];
+
+        if( field.mSlot == ModbusPduEnums::SlotLength )
+            length = value;
+
+        if( !show_fields )
+            continue;
+
+        // the names the file record sub-requests give the slots
+        const char* name = "RecordLen";
+        if( field.mSlot == ModbusPduEnums::SlotFunctionCode )
+            name = "RefType";
+        else if( field.mSlot == ModbusPduEnums::SlotPayload1 )
+            name = "FileNum";
+        else if( field.mSlot == ModbusPduEnums::SlotPayload2 )
+            name = "RecordNum";
+
+        text.Append( i > 0 ? ", " : " " );
+        text.Append( name );
+        text.Append( ": " );
+        formatter.AppendNumber( text, value, 8 * field.mSize );
+    }
+
+    if( layout.mBody == ModbusPduEnums::NoBody )
+        return;
+
+    U32 body_end = pdu_end;
+    if( length >= 0 )
+    {
+        length = length * layout.mLengthUnit - layout.mLengthAdjust;
+        if( length >= 0 && index + length < pdu_end )
+            body_end = index + U32( length );
+    }
+
+    if( layout.mBody == ModbusPduEnums::Groups )
+    {
+        while( index < body_end && values_left > 0 )
+            AppendPduItems( text, *layout.mGroup, true, adu, body_end, index, formatter, values_left );
+        return;
+    }
+
+    // a register cut in half by the length shows up as a single byte
+    text.Append( ", Values:" );
+    while( index < body_end )
+    {
+        if( values_left == 0 )
+        {
+            text.Append( " ..." );
+            index = body_end;
+            break;
+        }
+
+        U32 value = adu[ index++ ];
+        U32 bits = 8;
+        if( layout.mBody == ModbusPduEnums::Registers && index < body_end )
+        {
+            value = ( value << 8 ) | adu[ index++ ];
+            bits = 16;
+        }
+
+        text.Append( " " );
+        formatter.AppendNumber( text, value, bits );
+        values_left--;
+    }
+}
+
+void ModbusAnalyzerResults::GeneratePacketTabularText( U64 packet_id, DisplayBase display_base )
 {
     ClearResultStrings();
-    AddResultString( "not supported" );
+
+    // each ADU is committed as a packet of its own, around the ADU's one frame
+    U64 first_frame_id, last_frame_id;
+    GetFramesContainedInPacket( packet_id, &first_frame_id, &last_frame_id );
+    Frame frame = GetFrame( first_frame_id );
+
+    ModbusFrameFormatter formatter( display_base, mSettings->mBitsPerTransfer - 1 );
+    char text_str[ MODBUS_TEXT_SIZE ];
+    ModbusTextBuffer text( text_str, sizeof( text_str ) );
+
+    formatter.AppendName( text, frame );
+    AddResultString( text.GetText() );
+
+    text.Clear();
+    AppendFrameText( text, first_frame_id, frame, formatter, true, 32 );
+    AddResultString( text.GetText() );
 }
 
-void ModbusAnalyzerResults::GenerateTransactionTabularText(
-    U64 /*transaction_id*/, DisplayBase /*display_base*/ ) // unrefereced vars commented out to remove warnings.
+void ModbusAnalyzerResults::GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base )
 {
     ClearResultStrings();
-    AddResultString( "not supported" );
+
+    // a transaction is a request packet followed by the packet of its response
+    U64* packet_ids;
+    U64 packet_count;
+    GetPacketsContainedInTransaction( transaction_id, &packet_ids, &packet_count );
+    if( packet_count < 2 )
+        return;
+
+    U64 response_frame_id, last_frame_id;
+    GetFramesContainedInPacket( packet_ids[ packet_count - 1 ], &response_frame_id, &last_frame_id );
+    Frame response = GetFrame( response_frame_id );
+
+    ModbusFrameFormatter formatter( display_base, mSettings->mBitsPerTransfer - 1 );
+    char text_str[ MODBUS_TEXT_SIZE ];
+    ModbusTextBuffer text( text_str, sizeof( text_str ) );
+
+    // the response's name tells both what was asked and how it went: "Read Coils [ACK]", "Read Coils [NACK]"
+    formatter.AppendName( text, response );
+    AddResultString( text.GetText() );
+
+    text.Clear();
+    text.Append( "DeviceID: " );
+    formatter.AppendNumber( text, response.mData1 >> 56 );
+    text.Append( ", Func: " );
+    formatter.AppendName( text, response );
+    text.Append( " (" );
+    formatter.AppendNumber( text, ( response.mData1 >> 48 ) & 0xFF );
+    text.Append( ")" );
+    AddResultString( text.GetText() );
+
+    U64 turnaround = ( response.mData2 >> TURNAROUND_SHIFT ) & TURNAROUND_MAX;
+    char TurnaroundStr[ 128 ];
+    AnalyzerHelpers::GetTimeString( turnaround, 0, mAnalyzer->GetSampleRate(), TurnaroundStr, 128 );
+
+    text.Append( ", Turnaround: " );
+    text.Append( TurnaroundStr );
+    text.Append( " s" );
+    AddResultString( text.GetText() );
 }
@@ -2,9 +2,18 @@
 #define MODBUS_ANALYZER_RESULTS
 
 #include <AnalyzerResults.h>
+#include "ModbusTrafficStats.h"
+#include "ModbusFrameFormatter.h"
+#include "ModbusFrameIndex.h"
+#include "ModbusPayloadArena.h"
+#include "ModbusPduLayouts.h"
+#include "ModbusStringCache.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #define FRAMING_ERROR_FLAG ( 1 << 0 )
 #define PARITY_ERROR_FLAG ( 1 << 1 )
@@ -26,10 +35,50 @@ class ModbusAnalyzerResults : public AnalyzerResults
     virtual void GeneratePacketTabularText( U64 packet_id, DisplayBase display_base );
     virtual void GenerateTransactionTabularText( U64 transaction_id, DisplayBase display_base );
 
+    // the bytes behind a frame that doesn't hold the whole ADU
+    void AddPayload( U64 frame_index, const U8* data, U32 length );
+    U32 GetPayload( U64 frame_index, const U8*& data ) const;
+    // a Modbus mode frame's ADU as it went over the line, from its payload or else its fields; adu takes MODBUS_MAX_ADU_SIZE bytes
+    U32 GetAduBytes( U64 frame_index, const Frame& frame, U8* adu ) const;
+
+    // Modbus mode frames, by device, function code and error; line_errors for parity or framing errors within the ADU
+    void IndexFrame( U64 frame_index, const Frame& frame, bool line_errors );
+    void FindFrames( const ModbusFrameQuery& query, std::vector<U64>& frame_indexes );
+    // the frames that start within the query's times: first_frame up to, but not including, end_frame
+    void FindFrameRange( const ModbusFrameQuery& query, U64& first_frame, U64& end_frame );
+
+    // these stand in for the AnalyzerResults versions so that the strings for a frame can be kept in mStringCache as they're added
+    void ClearResultStrings();
+    void AddResultString( const char* str );
+    void ClearTabularText();
+    void AddTabularText( const char* str );
+
   protected: // functions
+    void FormatBubbleText( U64 frame_index, Channel& channel, DisplayBase display_base );
+    void FormatFrameTabularText( U64 frame_index, DisplayBase display_base );
+    void AppendFrameText( ModbusTextBuffer& text, U64 frame_index, const Frame& frame, const ModbusFrameFormatter& formatter, bool labels,
+                          U32 max_values );
+
+    void GenerateTrafficStatisticsFile( const char* file, DisplayBase display_base );
+    void GenerateBinaryFile( const char* file );
+    void GeneratePcapngFile( const char* file );
+    void GenerateColumnsFile( const char* file );
+    void GetExportFilter( ModbusFrameQuery& query ) const;
+    void AppendCounters( std::stringstream& ss, const char* label, const ModbusTrafficCounters& counters );
+    void AppendPduBody( ModbusTextBuffer& text, U64 frame_index, const Frame& frame, const ModbusFrameFormatter& formatter,
+                        U32 max_values );
+    void AppendPduItems( ModbusTextBuffer& text, const ModbusPduLayout& layout, bool show_fields, const U8* adu, U32 pdu_end, U32& index,
+                         const ModbusFrameFormatter& formatter, U32& values_left );
+
   protected: // vars
     ModbusAnalyzerSettings* mSettings;
     ModbusAnalyzer* mAnalyzer;
+    ModbusPayloadArena mPayloads;
+    ModbusFrameIndex mFrameIndex;
+
+    ModbusStringCache mStringCache;
+    std::vector<std::string> mBubbleStrings;
+    std::vector<std::string> mTabularStrings;
 };
 
 #endif // MODBUS_ANALYZER_RESULTS
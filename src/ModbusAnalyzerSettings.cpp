@@ -1,4 +1,5 @@
 #include "ModbusAnalyzerSettings.h"
+#include "ModbusFrameIndex.h"
 
 #include <AnalyzerHelpers.h>
 #include <sstream>
@@ -10,13 +11,15 @@
 
 ModbusAnalyzerSettings::ModbusAnalyzerSettings()
     : mInputChannel( UNDEFINED_CHANNEL ),
+      mResponseChannel( UNDEFINED_CHANNEL ),
       mBitRate( 9600 ),
       mBitsPerTransfer( 8 ),
       mShiftOrder( AnalyzerEnums::LsbFirst ),
       mParity( ModbusAnalyzerEnums::ParityAndStopbits::EvenOne ),
       mInverted( false ),
       mUseAutobaud( false ),
-      mModbusMode( ModbusAnalyzerEnums::ModbusRTUClient )
+      mModbusMode( ModbusAnalyzerEnums::ModbusRTUClient ),
+      mMarkerDensity( ModbusAnalyzerEnums::MarkersErrorsOnly )
 {
     mParityInterface.reset( new AnalyzerSettingInterfaceNumberList() );
     mParityInterface->SetTitleAndTooltip( "Parity Bit", "Specify None, Even, or Odd Parity" );
@@ -32,6 +35,13 @@ ModbusAnalyzerSettings::ModbusAnalyzerSettings()
                                                 "Modbus" ); // Todo: Change to reflect specific variant of Modbus later in program.
     mInputChannelInterface->SetChannel( mInputChannel );
 
+    mResponseChannelInterface.reset( new AnalyzerSettingInterfaceChannel() );
+    mResponseChannelInterface->SetTitleAndTooltip( "Modbus Response",
+                                                   "Full duplex modes only: the channel the servers respond on. The Modbus channel "
+                                                   "then only carries requests." );
+    mResponseChannelInterface->SetChannel( mResponseChannel );
+    mResponseChannelInterface->SetSelectionOfNoneIsAllowed( true );
+
 
     mModbusModeInterface.reset( new AnalyzerSettingInterfaceNumberList() );
     mModbusModeInterface->SetTitleAndTooltip( "Modbus Mode", "Specify which mode of Modbus this is" );
@@ -41,6 +51,14 @@ ModbusAnalyzerSettings::ModbusAnalyzerSettings()
                                      "Messages are transmitted in ASCII-readable format" );
     mModbusModeInterface->AddNumber( ModbusAnalyzerEnums::ModbusASCIIServer, "ASCII - Server",
                                      "Messages are transmitted in ASCII-readable format" );
+    mModbusModeInterface->AddNumber( ModbusAnalyzerEnums::ModbusRTUHalfDuplex, "RTU - Client and Server (half duplex)",
+                                     "Requests and responses share the channel, messages are transmitted in binary" );
+    mModbusModeInterface->AddNumber( ModbusAnalyzerEnums::ModbusASCIIHalfDuplex, "ASCII - Client and Server (half duplex)",
+                                     "Requests and responses share the channel, messages are transmitted in ASCII-readable format" );
+    mModbusModeInterface->AddNumber( ModbusAnalyzerEnums::ModbusRTUFullDuplex, "RTU - Client and Server (full duplex)",
+                                     "Requests and responses on separate channels, messages are transmitted in binary" );
+    mModbusModeInterface->AddNumber( ModbusAnalyzerEnums::ModbusASCIIFullDuplex, "ASCII - Client and Server (full duplex)",
+                                     "Requests and responses on separate channels, messages are transmitted in ASCII-readable format" );
     mModbusModeInterface->SetNumber( mModbusMode );
 
 
@@ -56,6 +74,27 @@ ModbusAnalyzerSettings::ModbusAnalyzerSettings()
     mInvertedInterface->AddNumber( false, "Non Inverted (Standard)", "" );
     mInvertedInterface->AddNumber( true, "Inverted", "" );
     mInvertedInterface->SetNumber( mInverted );
+
+
+    mMarkerDensityInterface.reset( new AnalyzerSettingInterfaceNumberList() );
+    mMarkerDensityInterface->SetTitleAndTooltip( "Bit Markers", "Specify which bit sampling markers are added to the waveform" );
+    mMarkerDensityInterface->AddNumber( ModbusAnalyzerEnums::MarkersErrorsOnly, "Errors Only (default)",
+                                        "Only parity and stop bit errors are marked; recommended for long captures" );
+    mMarkerDensityInterface->AddNumber( ModbusAnalyzerEnums::MarkersAll, "All Bits",
+                                        "Every data, parity and stop bit sample point is marked" );
+    mMarkerDensityInterface->AddNumber( ModbusAnalyzerEnums::MarkersNone, "None", "No markers are added" );
+    mMarkerDensityInterface->SetNumber( mMarkerDensity );
+
+
+    mExportFilterInterface.reset( new AnalyzerSettingInterfaceText() );
+    mExportFilterInterface->SetTitleAndTooltip( "Export Filter",
+                                                "Which frames the filtered export writes, e.g. \"device=17,18 function=3 from=60 to=360 "
+                                                "errors\". device= and function= take one or more numbers; from= and to= are seconds, as "
+                                                "in the export's time column; leave any of them out for all. Add exceptions, checksum, "
+                                                "truncated, line (parity or framing) or errors (any of them) for only the frames with "
+                                                "those errors." );
+    mExportFilterInterface->SetTextType( AnalyzerSettingInterfaceText::NormalText );
+    mExportFilterInterface->SetText( mExportFilter.c_str() );
     enum Mode
     {
         Normal,
@@ -67,19 +106,39 @@ ModbusAnalyzerSettings::ModbusAnalyzerSettings()
 
 
     AddInterface( mInputChannelInterface.get() );
+    AddInterface( mResponseChannelInterface.get() );
     AddInterface( mModbusModeInterface.get() );
     AddInterface( mBitRateInterface.get() );
     AddInterface( mInvertedInterface.get() );
     AddInterface( mParityInterface.get() );
+    AddInterface( mMarkerDensityInterface.get() );
+    AddInterface( mExportFilterInterface.get() );
 
 
     // AddExportOption( 0, "Export as text/csv file", "text (*.txt);;csv (*.csv)" );
-    AddExportOption( 0, "Export as text/csv file" );
-    AddExportExtension( 0, "text", "txt" );
-    AddExportExtension( 0, "csv", "csv" );
+    AddExportOption( ModbusAnalyzerEnums::ExportFrames, "Export as text/csv file" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportFrames, "text", "txt" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportFrames, "csv", "csv" );
+
+    AddExportOption( ModbusAnalyzerEnums::ExportTrafficStatistics, "Export traffic statistics as csv file" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportTrafficStatistics, "csv", "csv" );
+
+    AddExportOption( ModbusAnalyzerEnums::ExportFilteredFrames, "Export frames matching the export filter as text/csv file" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportFilteredFrames, "text", "txt" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportFilteredFrames, "csv", "csv" );
+
+    AddExportOption( ModbusAnalyzerEnums::ExportBinary, "Export frames as binary file" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportBinary, "binary", "bin" );
+
+    AddExportOption( ModbusAnalyzerEnums::ExportPcapng, "Export ADUs as pcapng file" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportPcapng, "pcapng", "pcapng" );
+
+    AddExportOption( ModbusAnalyzerEnums::ExportColumns, "Export fields in columns as csv file" );
+    AddExportExtension( ModbusAnalyzerEnums::ExportColumns, "csv", "csv" );
 
     ClearChannels();
     AddChannel( mInputChannel, "Modbus", false );
+    AddChannel( mResponseChannel, "Modbus Response", false );
 }
 
 ModbusAnalyzerSettings::~ModbusAnalyzerSettings()
@@ -96,7 +155,33 @@ bool ModbusAnalyzerSettings::SetSettingsFromInterfaces()
                 return false;
             }
     */
+    ModbusAnalyzerEnums::Mode mode = ModbusAnalyzerEnums::Mode( U32( mModbusModeInterface->GetNumber() ) );
+    Channel response_channel = mResponseChannelInterface->GetChannel();
+    if( mode == ModbusAnalyzerEnums::ModbusRTUFullDuplex || mode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
+    {
+        if( response_channel == UNDEFINED_CHANNEL )
+        {
+            SetErrorText( "Full duplex modes need a Modbus Response channel." );
+            return false;
+        }
+
+        if( response_channel == mInputChannelInterface->GetChannel() )
+        {
+            SetErrorText( "The Modbus and Modbus Response channels must be different." );
+            return false;
+        }
+    }
+
+    ModbusFrameQuery query;
+    std::string query_error;
+    if( !ParseModbusFrameQuery( mExportFilterInterface->GetText(), query, query_error ) )
+    {
+        SetErrorText( query_error.c_str() );
+        return false;
+    }
+
     mInputChannel = mInputChannelInterface->GetChannel();
+    mResponseChannel = response_channel;
     mBitRate = mBitRateInterface->GetInteger();
     // mBitsPerTransfer = U32( mBitsPerTransferInterface->GetNumber() );
     // mStopBits = mStopBitsInterface->GetNumber();
@@ -104,10 +189,13 @@ bool ModbusAnalyzerSettings::SetSettingsFromInterfaces()
     // mShiftOrder =  AnalyzerEnums::ShiftOrder( U32( mShiftOrderInterface->GetNumber() ) );
     mInverted = bool( U32( mInvertedInterface->GetNumber() ) );
     // mUseAutobaud = mUseAutobaudInterface->GetValue();
-    mModbusMode = ModbusAnalyzerEnums::Mode( U32( mModbusModeInterface->GetNumber() ) );
+    mModbusMode = mode;
+    mMarkerDensity = ModbusAnalyzerEnums::MarkerDensity( U32( mMarkerDensityInterface->GetNumber() ) );
+    mExportFilter = mExportFilterInterface->GetText();
 
     ClearChannels();
     AddChannel( mInputChannel, "Modbus", true );
+    AddChannel( mResponseChannel, "Modbus Response", IsFullDuplex() );
 
     return true;
 }
@@ -115,6 +203,7 @@ bool ModbusAnalyzerSettings::SetSettingsFromInterfaces()
 void ModbusAnalyzerSettings::UpdateInterfacesFromSettings()
 {
     mInputChannelInterface->SetChannel( mInputChannel );
+    mResponseChannelInterface->SetChannel( mResponseChannel );
     mBitRateInterface->SetInteger( mBitRate );
     // mBitsPerTransferInterface->SetNumber( mBitsPerTransfer );
     // mStopBitsInterface->SetNumber( mStopBits );
@@ -123,6 +212,8 @@ void ModbusAnalyzerSettings::UpdateInterfacesFromSettings()
     mInvertedInterface->SetNumber( mInverted );
     // mUseAutobaudInterface->SetValue( mUseAutobaud );
     mModbusModeInterface->SetNumber( mModbusMode );
+    mMarkerDensityInterface->SetNumber( mMarkerDensity );
+    mExportFilterInterface->SetText( mExportFilter.c_str() );
 }
 
 void ModbusAnalyzerSettings::LoadSettings( const char* settings )
@@ -160,9 +251,21 @@ void ModbusAnalyzerSettings::LoadSettings( const char* settings )
     if( text_archive >> *( U32* )&parity )
         mParity = parity;
 
+    ModbusAnalyzerEnums::MarkerDensity marker_density;
+    if( text_archive >> *( U32* )&marker_density )
+        mMarkerDensity = marker_density;
+
+    Channel response_channel;
+    if( text_archive >> response_channel )
+        mResponseChannel = response_channel;
+
+    const char* export_filter;
+    if( text_archive >> &export_filter )
+        mExportFilter = export_filter;
 
     ClearChannels();
     AddChannel( mInputChannel, "Modbus", true );
+    AddChannel( mResponseChannel, "Modbus Response", IsFullDuplex() );
 
     UpdateInterfacesFromSettings();
 }
@@ -187,5 +290,22 @@ const char* ModbusAnalyzerSettings::SaveSettings()
     // added for 1.2.14
     text_archive << mParity;
 
+    text_archive << mMarkerDensity;
+
+    text_archive << mResponseChannel;
+
+    text_archive << mExportFilter.c_str();
+
     return SetReturnString( text_archive.GetString() );
 }
+
+bool ModbusAnalyzerSettings::IsFullDuplex() const
+{
+    return mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex || mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex;
+}
+
+bool ModbusAnalyzerSettings::IsAsciiMode() const
+{
+    return mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient || mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer ||
+           mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex || mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex;
+}
@@ -3,6 +3,7 @@
 
 #include <AnalyzerSettings.h>
 #include <AnalyzerTypes.h>
+#include <string>
 
 #ifdef __GNUC__
 #include <stdio.h>
@@ -21,7 +22,11 @@ namespace ModbusAnalyzerEnums // Note: There is another definition of enum Mode
         ModbusASCIIServer,
         Normal,
         MpModeMsbZeroMeansAddress,
-        MpModeMsbOneMeansAddress
+        MpModeMsbOneMeansAddress,
+        ModbusRTUHalfDuplex, // requests and responses share the channel
+        ModbusASCIIHalfDuplex,
+        ModbusRTUFullDuplex, // requests on the input channel, responses on the response channel
+        ModbusASCIIFullDuplex
     };
     enum ParityAndStopbits
     {
@@ -30,6 +35,21 @@ namespace ModbusAnalyzerEnums // Note: There is another definition of enum Mode
         OddOne = AnalyzerEnums::Parity::Odd,
         NoneOne
     };
+    enum MarkerDensity
+    {
+        MarkersNone,
+        MarkersErrorsOnly,
+        MarkersAll
+    };
+    enum ExportType
+    {
+        ExportFrames,
+        ExportTrafficStatistics, // totals per device and function code, and bus utilization
+        ExportFilteredFrames,    // like ExportFrames, but only the frames that match mExportFilter
+        ExportBinary,            // fixed size records for tools to map, see ModbusBinaryExport.h
+        ExportPcapng,            // one packet per ADU, see ModbusPcapngExport.h
+        ExportColumns            // a column per field rather than a sentence per frame
+    };
 }
 
 class ModbusAnalyzerSettings : public AnalyzerSettings
@@ -43,8 +63,12 @@ class ModbusAnalyzerSettings : public AnalyzerSettings
     virtual void LoadSettings( const char* settings );
     virtual const char* SaveSettings();
 
+    bool IsFullDuplex() const;
+    bool IsAsciiMode() const;
+
     // User-modifiable settings - page 35.
     Channel mInputChannel;
+    Channel mResponseChannel; // full duplex modes only
     U32 mBitRate;
     U32 mBitsPerTransfer;
     AnalyzerEnums::ShiftOrder mShiftOrder;
@@ -52,10 +76,13 @@ class ModbusAnalyzerSettings : public AnalyzerSettings
     bool mInverted;
     bool mUseAutobaud;
     ModbusAnalyzerEnums::Mode mModbusMode;
+    ModbusAnalyzerEnums::MarkerDensity mMarkerDensity;
+    std::string mExportFilter; // a ModbusFrameQuery, see ParseModbusFrameQuery()
 
   protected:
     // AnalyzerSettingsInterfaces - page 36.
     std::auto_ptr<AnalyzerSettingInterfaceChannel> mInputChannelInterface;
+    std::auto_ptr<AnalyzerSettingInterfaceChannel> mResponseChannelInterface;
     std::auto_ptr<AnalyzerSettingInterfaceInteger> mBitRateInterface;
     std::auto_ptr<AnalyzerSettingInterfaceNumberList> mBitsPerTransferInterface;
     std::auto_ptr<AnalyzerSettingInterfaceNumberList> mShiftOrderInterface;
@@ -63,6 +90,8 @@ class ModbusAnalyzerSettings : public AnalyzerSettings
     std::auto_ptr<AnalyzerSettingInterfaceNumberList> mInvertedInterface;
     std::auto_ptr<AnalyzerSettingInterfaceBool> mUseAutobaudInterface;
     std::auto_ptr<AnalyzerSettingInterfaceNumberList> mModbusModeInterface;
+    std::auto_ptr<AnalyzerSettingInterfaceNumberList> mMarkerDensityInterface;
+    std::auto_ptr<AnalyzerSettingInterfaceText> mExportFilterInterface;
 };
 
 #endif // MODBUS_ANALYZER_SETTINGS
@@ -0,0 +1,50 @@
+#ifndef MODBUS_BINARY_EXPORT
+#define MODBUS_BINARY_EXPORT
+
+#include <LogicPublicTypes.h>
+
+// The binary export: one fixed size record per frame, so tools can map the file and use it in place instead of parsing text.
+// Everything is little-endian and every section starts on an 8 byte boundary.
+//
+//   header       MODBUS_BINARY_HEADER_SIZE bytes
+//   records      record_count records of MODBUS_BINARY_RECORD_SIZE bytes, in frame (and so time) order
+//   payloads     the ADU of every frame, address to checksum, back to back, padded to 8 bytes
+//   time index   time_index_count entries: the start sample of every MODBUS_BINARY_TIME_INDEX_STRIDE-th record, and its number
+//   device index 256 entries of ( first, count ) into the device record list that follows, then that list: the record numbers
+//                sorted by device, and by time within a device
+//   trailer      MODBUS_BINARY_TRAILER_SIZE bytes, last in the file, so a reader starts there
+//
+// header:   0 magic "MBADUBIN"  8 U32 version  12 U32 record size  16 U64 sample rate  24 U64 trigger sample
+// record:   0 U64 start sample  8 U64 end sample  16 U64 mData1  24 U64 mData2  32 U64 payload offset (from the start of the
+//           payloads)  40 U32 payload length  44 U8 device  45 U8 function code  46 U8 flags (FLAG_...)  47 U8 frame type
+// trailer:  0 U64 records offset  8 U64 record count  16 U64 payloads offset  24 U64 payloads size  32 U64 time index offset
+//           40 U64 time index count  48 U64 device index offset  56 magic "MBADUEND"
+//
+// Outside the Modbus modes a frame holds a single character: mData1 has its value, the device and function code are 0, and there
+// are no payloads.
+
+#define MODBUS_BINARY_VERSION 1
+#define MODBUS_BINARY_HEADER_SIZE 32
+#define MODBUS_BINARY_RECORD_SIZE 48
+#define MODBUS_BINARY_TRAILER_SIZE 64
+#define MODBUS_BINARY_TIME_INDEX_STRIDE 1024
+
+inline void ModbusPutU16( U8* data, U16 value )
+{
+    data[ 0 ] = U8( value );
+    data[ 1 ] = U8( value >> 8 );
+}
+
+inline void ModbusPutU32( U8* data, U32 value )
+{
+    for( U32 i = 0; i < 4; i++ )
+        data[ i ] = U8( value >> ( i * 8 ) );
+}
+
+inline void ModbusPutU64( U8* data, U64 value )
+{
+    for( U32 i = 0; i < 8; i++ )
+        data[ i ] = U8( value >> ( i * 8 ) );
+}
+
+#endif // MODBUS_BINARY_EXPORT
@@ -0,0 +1,141 @@
+#include "ModbusCrc.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#define MODBUS_CRC_PCLMUL
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#define MODBUS_CRC_PCLMUL_TARGET
+#else
+#include <cpuid.h>
+#define MODBUS_CRC_PCLMUL_TARGET __attribute__( ( target( "pclmul,sse2" ) ) )
+#endif
+#endif
+
+namespace
+{
+    // mSlices[ 0 ] is the classic byte-at-a-time table. mSlices[ k ] holds the CRC of a byte followed by k zero bytes,
+    // which lets the main loop fold eight bytes per iteration with independent lookups.
+    struct Crc16Tables
+    {
+        U16 mSlices[ 8 ][ 256 ];
+
+        Crc16Tables()
+        {
+            for( U32 i = 0; i < 256; i++ )
+            {
+                U16 crc = i;
+                for( U32 j = 0; j < 8; j++ )
+                {
+                    if( crc & 0x0001 )
+                        crc = ( crc >> 1 ) ^ 0xA001;
+                    else
+                        crc = crc >> 1;
+                }
+
+                mSlices[ 0 ][ i ] = crc;
+            }
+
+            for( U32 i = 0; i < 256; i++ )
+                for( U32 k = 1; k < 8; k++ )
+                    mSlices[ k ][ i ] = ( mSlices[ k - 1 ][ i ] >> 8 ) ^ mSlices[ 0 ][ mSlices[ k - 1 ][ i ] & 0xFF ];
+        }
+    };
+
+    const Crc16Tables gTables;
+
+    U16 UpdateSliceBy8( U16 crc, const U8* data, size_t length )
+    {
+        const U16( *t )[ 256 ] = gTables.mSlices;
+
+        while( length >= 8 )
+        {
+            U32 lo = ( data[ 0 ] | ( data[ 1 ] << 8 ) ) ^ crc;
+            crc = t[ 7 ][ lo & 0xFF ] ^ t[ 6 ][ lo >> 8 ] ^ t[ 5 ][ data[ 2 ] ] ^ t[ 4 ][ data[ 3 ] ] ^ t[ 3 ][ data[ 4 ] ] ^
+                  t[ 2 ][ data[ 5 ] ] ^ t[ 1 ][ data[ 6 ] ] ^ t[ 0 ][ data[ 7 ] ];
+            data += 8;
+            length -= 8;
+        }
+
+        while( length-- > 0 )
+            crc = ( crc >> 8 ) ^ t[ 0 ][ ( crc ^ *data++ ) & 0xFF ];
+
+        return crc;
+    }
+
+#ifdef MODBUS_CRC_PCLMUL
+    // Folding with carry-less multiplication. The running remainder is kept as a 128 bit block in the reflected bit order
+    // the bytes arrive in: its first 8 bytes are the x^127..x^64 coefficients and its last 8 bytes x^63..x^0. Advancing
+    // the block over the next 16 bytes multiplies it by x^128, so each half is multiplied by (x^192 mod P) and
+    // (x^128 mod P) respectively and the products, which are at most 80 bits wide, are xored into the next block.
+    // A reflected product comes out one bit position short, i.e. multiplied by an extra x, so the constants used are
+    // x^191 and x^127 mod P.
+    // Whatever is left is finished with the slice-by-8 tables, starting from zero since the initial value was folded in.
+    const size_t kFoldMinimumLength = 32;
+
+    MODBUS_CRC_PCLMUL_TARGET U16 UpdatePclmul( U16 crc, const U8* data, size_t length )
+    {
+        const __m128i fold_constants = _mm_set_epi64x( 0xC100000000000000ULL /* x^127 */, 0xCCD0000000000000ULL /* x^191 */ );
+
+        __m128i remainder = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast<const __m128i*>( data ) ), _mm_cvtsi32_si128( crc ) );
+        data += 16;
+        length -= 16;
+
+        while( length >= 16 )
+        {
+            __m128i next = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data ) );
+            next = _mm_xor_si128( next, _mm_clmulepi64_si128( remainder, fold_constants, 0x00 ) );
+            remainder = _mm_xor_si128( next, _mm_clmulepi64_si128( remainder, fold_constants, 0x11 ) );
+            data += 16;
+            length -= 16;
+        }
+
+        U8 folded[ 16 ];
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( folded ), remainder );
+
+        crc = UpdateSliceBy8( 0, folded, sizeof( folded ) );
+        return UpdateSliceBy8( crc, data, length );
+    }
+
+    bool CpuSupportsPclmul()
+    {
+        U32 ecx, edx;
+#if defined( _MSC_VER )
+        int regs[ 4 ];
+        __cpuid( regs, 1 );
+        ecx = regs[ 2 ];
+        edx = regs[ 3 ];
+#else
+        U32 eax, ebx;
+        if( __get_cpuid( 1, &eax, &ebx, &ecx, &edx ) == 0 )
+            return false;
+#endif
+        const U32 pclmulqdq = 1 << 1; // CPUID.1:ECX
+        const U32 sse2 = 1 << 26;     // CPUID.1:EDX
+        return ( ecx & pclmulqdq ) && ( edx & sse2 );
+    }
+
+    const bool gUsePclmul = CpuSupportsPclmul();
+#endif
+}
+
+U16 crc16_modbus( const U8* data, size_t length )
+{
+    return crc16_modbus_update( MODBUS_CRC_INITIAL_VALUE, data, length );
+}
+
+U16 crc16_modbus_update( U16 crc, const U8* data, size_t length )
+{
+#ifdef MODBUS_CRC_PCLMUL
+    if( gUsePclmul && length >= kFoldMinimumLength )
+        return UpdatePclmul( crc, data, length );
+#endif
+
+    return UpdateSliceBy8( crc, data, length );
+}
+
+U16 crc16_modbus_update( U16 crc, U8 value )
+{
+    return ( crc >> 8 ) ^ gTables.mSlices[ 0 ][ ( crc ^ value ) & 0xFF ];
+}
@@ -0,0 +1,18 @@
+#ifndef MODBUS_CRC
+#define MODBUS_CRC
+
+#include <LogicPublicTypes.h>
+#include <stddef.h>
+
+// CRC-16/MODBUS: reflected polynomial 0xA001, initial value 0xFFFF, no final xor.
+// The result is transmitted low byte first.
+#define MODBUS_CRC_INITIAL_VALUE 0xFFFF
+
+// CRC of a complete buffer
+U16 crc16_modbus( const U8* data, size_t length );
+
+// continue a running CRC over more data; start from MODBUS_CRC_INITIAL_VALUE
+U16 crc16_modbus_update( U16 crc, const U8* data, size_t length );
+U16 crc16_modbus_update( U16 crc, U8 value );
+
+#endif // MODBUS_CRC
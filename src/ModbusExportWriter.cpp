@@ -0,0 +1,209 @@
+#include "ModbusExportWriter.h"
+#include <AnalyzerHelpers.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+ModbusExportWriter::Chunk::Chunk() : mLength( 0 ), mDone( false )
+{
+}
+
+ModbusExportWriter::ModbusExportWriter( const char* file )
+    : mFile( AnalyzerHelpers::StartFile( file ) ), mBuffer( MODBUS_EXPORT_BUFFER_SIZE ), mLength( 0 )
+{
+}
+
+ModbusExportWriter::~ModbusExportWriter()
+{
+    Close();
+}
+
+void ModbusExportWriter::Append( const char* str )
+{
+    Append( str, U32( strlen( str ) ) );
+}
+
+void ModbusExportWriter::Append( const char* data, U32 length )
+{
+    if( mLength + length > mBuffer.size() )
+        Flush();
+
+    // too big to be worth copying
+    if( length > mBuffer.size() )
+    {
+        if( mFile != NULL )
+            AnalyzerHelpers::AppendToFile( ( U8* )data, length, mFile );
+        return;
+    }
+
+    memcpy( &mBuffer[ mLength ], data, length );
+    mLength += length;
+}
+
+ModbusTextBuffer ModbusExportWriter::StartLine( U32 max_length )
+{
+    // room for the line and the terminator ModbusTextBuffer keeps after it
+    if( mLength + max_length + 1 > mBuffer.size() )
+    {
+        Flush();
+        if( max_length + 1 > mBuffer.size() )
+            mBuffer.resize( max_length + 1 );
+    }
+
+    return ModbusTextBuffer( &mBuffer[ mLength ], max_length + 1 );
+}
+
+void ModbusExportWriter::EndLine( const ModbusTextBuffer& line )
+{
+    mLength += line.GetLength();
+}
+
+bool ModbusExportWriter::WriteLines( U64 line_count, U32 max_line_length, const FrameFetcher& fetch_frame, const LineFormatter& format_line,
+                                     const ProgressCallback& progress, bool in_parallel )
+{
+    // this thread fetches the frames and writes the chunks, so the workers are the cores left over
+    U64 chunk_count = ( line_count + MODBUS_EXPORT_CHUNK_LINES - 1 ) / MODBUS_EXPORT_CHUNK_LINES;
+    U32 core_count = std::thread::hardware_concurrency();
+    U32 thread_count = core_count > 1 ? core_count - 1 : 0;
+    if( thread_count > chunk_count )
+        thread_count = U32( chunk_count );
+
+    if( !in_parallel || thread_count == 0 || chunk_count < 2 )
+        return WriteLinesInOrder( line_count, max_line_length, fetch_frame, format_line, progress );
+
+    return WriteLinesInParallel( line_count, max_line_length, thread_count, fetch_frame, format_line, progress );
+}
+
+bool ModbusExportWriter::WriteLinesInOrder( U64 line_count, U32 max_line_length, const FrameFetcher& fetch_frame,
+                                            const LineFormatter& format_line, const ProgressCallback& progress )
+{
+    for( U64 i = 0; i < line_count; i++ )
+    {
+        ModbusTextBuffer line = StartLine( max_line_length );
+        format_line( i, fetch_frame( i ), line );
+        EndLine( line );
+
+        if( i % MODBUS_EXPORT_PROGRESS_LINES == 0 && progress( i ) )
+            return false;
+    }
+
+    return true;
+}
+
+bool ModbusExportWriter::WriteLinesInParallel( U64 line_count, U32 max_line_length, U32 thread_count, const FrameFetcher& fetch_frame,
+                                               const LineFormatter& format_line, const ProgressCallback& progress )
+{
+    U64 chunk_count = ( line_count + MODBUS_EXPORT_CHUNK_LINES - 1 ) / MODBUS_EXPORT_CHUNK_LINES;
+
+    // only so many chunks are fetched ahead of the one being written, which keeps memory in check
+    U64 window = U64( thread_count ) * 2;
+
+    std::vector<Chunk> chunks( chunk_count );
+    std::mutex mutex;
+    std::condition_variable chunk_fetched;
+    std::condition_variable chunk_done;
+    U64 chunks_fetched = 0; // the workers may take chunks up to here
+    U64 next_chunk = 0;     // the next one for a worker to take
+    bool cancelled = false;
+
+    std::vector<std::thread> threads;
+    for( U32 i = 0; i < thread_count; i++ )
+        threads.push_back( std::thread( [&]() {
+            for( ;; )
+            {
+                U64 chunk_index;
+                {
+                    std::unique_lock<std::mutex> lock( mutex );
+                    chunk_fetched.wait( lock, [&]() { return cancelled || next_chunk == chunk_count || next_chunk < chunks_fetched; } );
+                    if( cancelled || next_chunk == chunk_count )
+                        return;
+                    chunk_index = next_chunk++;
+                }
+
+                FormatChunk( chunks[ chunk_index ], chunk_index * MODBUS_EXPORT_CHUNK_LINES, max_line_length, format_line );
+
+                std::lock_guard<std::mutex> lock( mutex );
+                chunks[ chunk_index ].mDone = true;
+                chunk_done.notify_all();
+            }
+        } ) );
+
+    U64 fetching = 0;
+    for( U64 chunk_index = 0; chunk_index < chunk_count; chunk_index++ )
+    {
+        // keep the workers supplied, fetching frames only ever from this thread
+        for( ; fetching < chunk_count && fetching < chunk_index + window; fetching++ )
+        {
+            U64 first_line = fetching * MODBUS_EXPORT_CHUNK_LINES;
+            U64 end_line = std::min( first_line + MODBUS_EXPORT_CHUNK_LINES, line_count );
+
+            std::vector<Frame>& frames = chunks[ fetching ].mFrames;
+            frames.resize( size_t( end_line - first_line ) );
+            for( U64 line = first_line; line < end_line; line++ )
+                frames[ size_t( line - first_line ) ] = fetch_frame( line );
+
+            std::lock_guard<std::mutex> lock( mutex );
+            chunks_fetched = fetching + 1;
+            chunk_fetched.notify_all();
+        }
+
+        Chunk& chunk = chunks[ chunk_index ];
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            chunk_done.wait( lock, [&]() { return chunk.mDone; } );
+        }
+
+        Append( chunk.mText.data(), chunk.mLength );
+        std::vector<char>().swap( chunk.mText );
+
+        U64 lines_written = std::min( ( chunk_index + 1 ) * MODBUS_EXPORT_CHUNK_LINES, line_count );
+        if( progress( lines_written ) )
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            cancelled = true;
+            chunk_fetched.notify_all();
+            break;
+        }
+    }
+
+    for( U32 i = 0; i < threads.size(); i++ )
+        threads[ i ].join();
+
+    return !cancelled;
+}
+
+void ModbusExportWriter::FormatChunk( Chunk& chunk, U64 first_line, U32 max_line_length, const LineFormatter& format_line )
+{
+    // most lines are far shorter than the most they can be, so the buffer grows as it fills rather than up front
+    for( size_t i = 0; i < chunk.mFrames.size(); i++ )
+    {
+        if( chunk.mLength + max_line_length + 1 > chunk.mText.size() )
+            chunk.mText.resize( std::max<size_t>( chunk.mText.size() * 2, chunk.mLength + max_line_length + 1 ) );
+
+        ModbusTextBuffer line( &chunk.mText[ chunk.mLength ], max_line_length + 1 );
+        format_line( first_line + i, chunk.mFrames[ i ], line );
+        chunk.mLength += line.GetLength();
+    }
+
+    std::vector<Frame>().swap( chunk.mFrames );
+}
+
+void ModbusExportWriter::Flush()
+{
+    if( mLength != 0 && mFile != NULL )
+        AnalyzerHelpers::AppendToFile( ( U8* )&mBuffer[ 0 ], mLength, mFile );
+    mLength = 0;
+}
+
+void ModbusExportWriter::Close()
+{
+    if( mFile == NULL )
+        return;
+
+    Flush();
+    AnalyzerHelpers::EndFile( mFile );
+    mFile = NULL;
+}
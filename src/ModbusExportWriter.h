@@ -0,0 +1,74 @@
+#ifndef MODBUS_EXPORT_WRITER
+#define MODBUS_EXPORT_WRITER
+
+#include <LogicPublicTypes.h>
+#include "ModbusFrameFormatter.h"
+
+#include <functional>
+#include <vector>
+
+// how much export text is collected before it goes to the file
+#define MODBUS_EXPORT_BUFFER_SIZE ( 4 << 20 )
+// how many lines go by between progress updates
+#define MODBUS_EXPORT_PROGRESS_LINES 4096
+// how many lines a worker thread formats at a time
+#define MODBUS_EXPORT_CHUNK_LINES 16384
+
+// Collects export text in one big buffer and hands it to AnalyzerHelpers::AppendToFile() a few megabytes at a time, rather than
+// a line at a time. Lines are written straight into the buffer: StartLine() makes room for one and returns a ModbusTextBuffer
+// over it, and EndLine() keeps whatever was written.
+class ModbusExportWriter
+{
+  public:
+    // the frame behind a line, given its number; only ever called on the thread that called WriteLines()
+    typedef std::function<Frame( U64 line )> FrameFetcher;
+    // formats one line, given its number and frame, into the text; may run on several threads at once when WriteLines() is told
+    // it can, so it must leave the SDK alone
+    typedef std::function<void( U64 line, const Frame& frame, ModbusTextBuffer& text )> LineFormatter;
+    // called with how many lines have been written, on the thread that called WriteLines(); returns true to cancel
+    typedef std::function<bool( U64 lines_written )> ProgressCallback;
+
+    ModbusExportWriter( const char* file );
+    ~ModbusExportWriter(); // closes the file, if Close() hasn't already
+
+    void Append( const char* str );
+    void Append( const char* data, U32 length );
+
+    ModbusTextBuffer StartLine( U32 max_length );
+    void EndLine( const ModbusTextBuffer& line );
+
+    // Writes lines 0 to line_count - 1, reporting progress as it goes. Returns false if cancelled.
+    //
+    // With more than one core and in_parallel set, the lines are split into chunks of MODBUS_EXPORT_CHUNK_LINES. This thread
+    // fetches the frames of a chunk and hands them to a pool of worker threads, each of which formats whole chunks into a buffer of
+    // its own; the chunks are then written out in order, here. Otherwise each line is formatted straight into the buffer.
+    bool WriteLines( U64 line_count, U32 max_line_length, const FrameFetcher& fetch_frame, const LineFormatter& format_line,
+                     const ProgressCallback& progress, bool in_parallel );
+
+    // writes out what's been collected; done as needed, and by Close()
+    void Flush();
+    void Close();
+
+  protected:
+    struct Chunk
+    {
+        Chunk();
+
+        std::vector<Frame> mFrames;
+        std::vector<char> mText;
+        U32 mLength;
+        bool mDone;
+    };
+
+    bool WriteLinesInOrder( U64 line_count, U32 max_line_length, const FrameFetcher& fetch_frame, const LineFormatter& format_line,
+                            const ProgressCallback& progress );
+    bool WriteLinesInParallel( U64 line_count, U32 max_line_length, U32 thread_count, const FrameFetcher& fetch_frame,
+                               const LineFormatter& format_line, const ProgressCallback& progress );
+    static void FormatChunk( Chunk& chunk, U64 first_line, U32 max_line_length, const LineFormatter& format_line );
+
+    void* mFile;
+    std::vector<char> mBuffer;
+    U32 mLength;
+};
+
+#endif // MODBUS_EXPORT_WRITER
@@ -0,0 +1,369 @@
+#include "ModbusFrameFormatter.h"
+#include "ModbusAnalyzerModbusExtension.h"
+#include "ModbusPduLayouts.h"
+
+#include <AnalyzerHelpers.h>
+#include <string.h>
+
+using namespace ModbusPduEnums;
+
+#define TEXT_FIELDS( fields ) fields, sizeof( fields ) / sizeof( fields[ 0 ] )
+#define TEXT_NO_FIELDS NULL, 0
+
+static const ModbusTextField ChecksumOnly[] = { { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField ByteCountOnly[] = { { "ByteCount", SlotLength, false, ColumnByteCount } };
+static const ModbusTextField StartAndQuantity[] = { { "StartAddr", SlotPayload1, false, ColumnStartAddress },
+                                                    { "Qty", SlotPayload2, false, ColumnQuantity },
+                                                    { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField StartQuantityAndByteCount[] = { { "StartAddr", SlotPayload1, false, ColumnStartAddress },
+                                                             { "Qty", SlotPayload2, false, ColumnQuantity },
+                                                             { "ByteCount", SlotLength, false, ColumnByteCount } };
+static const ModbusTextField AddressAndValue[] = { { "Addr", SlotPayload1, false, ColumnStartAddress },
+                                                   { "Value", SlotPayload2, false, ColumnNone },
+                                                   { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField ExceptionStatus[] = { { "Value", SlotPayload1, false, ColumnNone },
+                                                   { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField Diagnostics[] = { { "SubFunc", SlotPayload1, true, ColumnNone },
+                                               { "Data", SlotPayload2, false, ColumnNone },
+                                               { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField ComEventCounter[] = { { "Status", SlotPayload1, false, ColumnNone },
+                                                   { "Count", SlotPayload2, false, ColumnNone },
+                                                   { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField ComEventLog[] = { { "Status", SlotPayload1, false, ColumnNone },
+                                               { "EventCnt", SlotPayload4, false, ColumnNone },
+                                               { "MsgCnt", SlotPayload3, false, ColumnNone },
+                                               { "ByteCount", SlotLength, false, ColumnByteCount } };
+static const ModbusTextField MaskWrite[] = { { "RefAddr", SlotPayload1, false, ColumnStartAddress },
+                                             { "And_Mask", SlotPayload2, false, ColumnNone },
+                                             { "OR_Mask", SlotPayload3, false, ColumnNone },
+                                             { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField ReadWriteMultiple[] = { { "ReadStartAddr", SlotPayload1, false, ColumnStartAddress },
+                                                     { "ReadQty", SlotPayload2, false, ColumnQuantity },
+                                                     { "WriteStartAddr", SlotPayload4, false, ColumnNone },
+                                                     { "WriteQty", SlotPayload3, false, ColumnNone },
+                                                     { "ByteCount", SlotLength, false, ColumnByteCount } };
+static const ModbusTextField FifoAddress[] = { { "Addr", SlotPayload1, false, ColumnStartAddress },
+                                               { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField FifoQueue[] = { { "ByteCount", SlotLength, false, ColumnByteCount },
+                                             { "FIFO Count", SlotPayload2, false, ColumnNone } };
+static const ModbusTextField DeviceIdRequest[] = { { "MEI", SlotPayload1, false, ColumnNone },
+                                                   { "ReadIDCode", SlotPayload2, false, ColumnNone },
+                                                   { "ObjID", SlotPayload3, false, ColumnNone },
+                                                   { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField DeviceIdResponse[] = { { "MEI", SlotPayload1, false, ColumnNone },
+                                                    { "ReadIDCode", SlotPayload2, false, ColumnNone },
+                                                    { "ChkSum", SlotLength, false, ColumnNone } };
+static const ModbusTextField Exception[] = { { "ExceptionCode", SlotPayload1, false, ColumnExceptionCode },
+                                             { "ChkSum", SlotLength, false, ColumnNone } };
+
+const ModbusFunctionText gModbusFunctionTexts[] = {
+    { FUNCCODE_READ_COILS, "Read Coils", TEXT_FIELDS( StartAndQuantity ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_READ_DISCRETE_INPUTS, "Read Discrete Inputs", TEXT_FIELDS( StartAndQuantity ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_READ_HOLDING_REGISTERS, "Read Holding Registers", TEXT_FIELDS( StartAndQuantity ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_READ_INPUT_REGISTER, "Read Input Registers", TEXT_FIELDS( StartAndQuantity ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_WRITE_SINGLE_COIL, "Write Single Coil", TEXT_FIELDS( AddressAndValue ), TEXT_FIELDS( AddressAndValue ) },
+    { FUNCCODE_WRITE_SINGLE_REGISTER, "Write Single Register", TEXT_FIELDS( AddressAndValue ), TEXT_FIELDS( AddressAndValue ) },
+    { FUNCCODE_READ_EXCEPTION_STATUS, "Read Exception Status", TEXT_FIELDS( ChecksumOnly ), TEXT_FIELDS( ExceptionStatus ) },
+    { FUNCCODE_DIAGNOSTIC, "Diagnostics", TEXT_FIELDS( Diagnostics ), TEXT_FIELDS( Diagnostics ) },
+    { FUNCCODE_GET_COM_EVENT_COUNTER, "Get Comm Event Counter", TEXT_FIELDS( ChecksumOnly ), TEXT_FIELDS( ComEventCounter ) },
+    { FUNCCODE_GET_COM_EVENT_LOG, "Get Comm Event Log", TEXT_FIELDS( ChecksumOnly ), TEXT_FIELDS( ComEventLog ) },
+    { FUNCCODE_WRITE_MULTIPLE_COILS, "Write Multiple Coils", TEXT_FIELDS( StartQuantityAndByteCount ), TEXT_FIELDS( StartAndQuantity ) },
+    { FUNCCODE_WRITE_MULTIPLE_REGISTERS, "Write Multiple Registers", TEXT_FIELDS( StartQuantityAndByteCount ),
+      TEXT_FIELDS( StartAndQuantity ) },
+    { FUNCCODE_REPORT_SERVER_ID, "Report Server ID", TEXT_FIELDS( ChecksumOnly ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_READ_FILE_RECORD, "Read File Record", TEXT_FIELDS( ByteCountOnly ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_WRITE_FILE_RECORD, "Write File Record", TEXT_FIELDS( ByteCountOnly ), TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_MASK_WRITE_REGISTER, "Mask Write Register", TEXT_FIELDS( MaskWrite ), TEXT_FIELDS( MaskWrite ) },
+    { FUNCCODE_READWRITE_MULTIPLE_REGISTERS, "Read/Write Multiple Registers", TEXT_FIELDS( ReadWriteMultiple ),
+      TEXT_FIELDS( ByteCountOnly ) },
+    { FUNCCODE_READ_FIFO_QUEUE, "Read FIFO Queue", TEXT_FIELDS( FifoAddress ), TEXT_FIELDS( FifoQueue ) },
+    { FUNCCODE_READ_DEVICE_ID, "Read Device ID", TEXT_FIELDS( DeviceIdRequest ), TEXT_FIELDS( DeviceIdResponse ) },
+};
+
+const U32 gModbusFunctionTextCount = sizeof( gModbusFunctionTexts ) / sizeof( gModbusFunctionTexts[ 0 ] );
+
+static const ModbusFunctionText UserDefinedFunction = { 0, "User Defined Function", TEXT_NO_FIELDS, TEXT_NO_FIELDS };
+
+// gModbusFunctionTexts by function code, so that looking one up doesn't walk the list for every frame formatted
+struct FunctionTextsByCode
+{
+    FunctionTextsByCode()
+    {
+        for( U32 i = 0; i < 256; i++ )
+            mTexts[ i ] = &UserDefinedFunction;
+        for( U32 i = 0; i < gModbusFunctionTextCount; i++ )
+            mTexts[ gModbusFunctionTexts[ i ].mFunctionCode ] = &gModbusFunctionTexts[ i ];
+    }
+
+    const ModbusFunctionText* mTexts[ 256 ];
+};
+
+static const FunctionTextsByCode gFunctionTextsByCode;
+
+static const ModbusSubFunctionText DiagnosticSubFunctions[] = {
+    { RETURN_QUERY_DATA, "Return Query Data" },
+    { RESTART_COMMUNICATIONS_OPTION, "Restart Comms Option" },
+    { RETURN_DIAGNOSTIC_REGISTER, "Return Diag Reg" },
+    { CHANGE_ASCII_INPUT_DELIM, "Change ASCII Input Delim" },
+    { FORCE_LISTEN_ONLY_MODE, "Force Listen Only Mode" },
+    { CLEAR_COUNTERS_AND_DIAG_REGISTER, "Clr Counters And Diag Reg" },
+    { RETURN_BUS_MESSAGE_COUNT, "Bus Msg Cnt" },
+    { RETURN_BUS_COMM_ERROR_COUNT, "Bus Comm Err Cnt" },
+    { RETURN_BUS_EXCEPTION_ERROR_COUNT, "Bus Excpt Err Cnt" },
+    { RETURN_SERVER_MESSAGE_COUNT, "Server Msg Cnt" },
+    { RETURN_SERVER_NO_RESPONSE_COUNT, "Server No Resp Cnt" },
+    { RETURN_SERVER_NAK_COUNT, "Server NAK Cnt" },
+    { RETURN_SERVER_BUSY_COUNT, "Server Busy Cnt" },
+    { RETURN_BUS_CHAR_OVERRUN_COUNT, "Bus Char Overrun Cnt" },
+    { CLEAR_OVERRUN_COUNTER_AND_FLAG, "Clear Overrun Cnt" },
+};
+
+U16 ModbusFrameFormatter::GetSlotValue( const Frame& frame, U8 slot )
+{
+    switch( slot )
+    {
+    case SlotPayload1:
+        return ( frame.mData1 >> 32 ) & 0xFFFF;
+    case SlotPayload2:
+        return ( frame.mData1 >> 16 ) & 0xFFFF;
+    case SlotPayload3:
+        return frame.mData2 & 0xFFFF;
+    case SlotPayload4:
+        return ( frame.mData2 >> 16 ) & 0xFFFF;
+    case SlotLength:
+        return frame.mData1 & 0xFFFF;
+    default:
+        return ( frame.mData1 >> 48 ) & 0xFF;
+    }
+}
+
+ModbusTextBuffer::ModbusTextBuffer( char* buffer, U32 size ) : mBuffer( buffer ), mSize( size ), mLength( 0 )
+{
+    mBuffer[ 0 ] = '\0';
+}
+
+void ModbusTextBuffer::Append( const char* str )
+{
+    Append( str, U32( strlen( str ) ) );
+}
+
+void ModbusTextBuffer::Append( const char* str, U32 length )
+{
+    if( length > mSize - 1 - mLength )
+        length = mSize - 1 - mLength;
+
+    memcpy( mBuffer + mLength, str, length );
+    mLength += length;
+    mBuffer[ mLength ] = '\0';
+}
+
+void ModbusTextBuffer::Clear()
+{
+    mLength = 0;
+    mBuffer[ 0 ] = '\0';
+}
+
+const char* ModbusTextBuffer::GetText() const
+{
+    return mBuffer;
+}
+
+U32 ModbusTextBuffer::GetLength() const
+{
+    return mLength;
+}
+
+ModbusFrameFormatter::ModbusFrameFormatter( DisplayBase display_base, U32 bits_per_transfer )
+    : mDisplayBase( display_base ), mBitsPerTransfer( bits_per_transfer )
+{
+}
+
+void ModbusFrameFormatter::AppendNumber( ModbusTextBuffer& text, U64 value, U32 bits ) const
+{
+    // digits are written back to front from the end of the buffer
+    char number_str[ 128 ];
+    char* end = number_str + sizeof( number_str );
+    char* start = end;
+
+    switch( mDisplayBase )
+    {
+    case Hexadecimal:
+    {
+        // zero padded to the width of the data, the way GetNumberString() does it
+        U32 width = bits == 0 ? 16 : ( bits + 3 ) / 4;
+        do
+        {
+            *--start = "0123456789ABCDEF"[ value & 0xF ];
+            value >>= 4;
+        } while( value != 0 );
+
+        while( U32( end - start ) < width )
+            *--start = '0';
+
+        *--start = 'x';
+        *--start = '0';
+        break;
+    }
+    case Decimal:
+        do
+        {
+            *--start = char( '0' + value % 10 );
+            value /= 10;
+        } while( value != 0 );
+        break;
+    default:
+        AnalyzerHelpers::GetNumberString( value, mDisplayBase, bits, number_str, sizeof( number_str ) );
+        text.Append( number_str );
+        return;
+    }
+
+    text.Append( start, U32( end - start ) );
+}
+
+bool ModbusFrameFormatter::IsReentrant() const
+{
+    return mDisplayBase == Hexadecimal || mDisplayBase == Decimal;
+}
+
+void ModbusFrameFormatter::AppendTime( ModbusTextBuffer& text, U64 sample, U64 trigger_sample, U32 sample_rate )
+{
+    // seconds from the trigger, rounded to the nanosecond; all integer math, so no rounding surprises far into a long capture
+    U64 samples = sample >= trigger_sample ? sample - trigger_sample : trigger_sample - sample;
+    U64 seconds = samples / sample_rate;
+    U64 nanoseconds = ( ( samples % sample_rate ) * 1000000000ULL + sample_rate / 2 ) / sample_rate;
+    if( nanoseconds == 1000000000ULL )
+    {
+        seconds++;
+        nanoseconds = 0;
+    }
+
+    char time_str[ 32 ];
+    char* end = time_str + sizeof( time_str );
+    char* start = end;
+
+    for( U32 i = 0; i < 9; i++ )
+    {
+        *--start = char( '0' + nanoseconds % 10 );
+        nanoseconds /= 10;
+    }
+    *--start = '.';
+    do
+    {
+        *--start = char( '0' + seconds % 10 );
+        seconds /= 10;
+    } while( seconds != 0 );
+
+    if( sample < trigger_sample )
+        *--start = '-';
+
+    text.Append( start, U32( end - start ) );
+}
+
+void ModbusFrameFormatter::AppendNumber( ModbusTextBuffer& text, U64 value ) const
+{
+    AppendNumber( text, value, mBitsPerTransfer );
+}
+
+void ModbusFrameFormatter::AppendName( ModbusTextBuffer& text, const Frame& frame ) const
+{
+    U8 funccode = ( frame.mData1 >> 48 ) & 0xFF;
+
+    if( frame.mFlags & FLAG_EXCEPTION_FRAME )
+    {
+        text.Append( FindFunction( funccode & 0x7F )->mName );
+        text.Append( " [NACK]" );
+    }
+    else
+    {
+        text.Append( FindFunction( funccode )->mName );
+        if( frame.mFlags & FLAG_RESPONSE_FRAME )
+            text.Append( " [ACK]" );
+    }
+}
+
+const char* ModbusFrameFormatter::GetSubFunctionName( const Frame& frame ) const
+{
+    if( ( ( frame.mData1 >> 48 ) & 0xFF ) != FUNCCODE_DIAGNOSTIC )
+        return NULL;
+
+    U16 sub_function = GetSlotValue( frame, SlotPayload1 );
+    for( U32 i = 0; i < sizeof( DiagnosticSubFunctions ) / sizeof( DiagnosticSubFunctions[ 0 ] ); i++ )
+        if( DiagnosticSubFunctions[ i ].mSubFunction == sub_function )
+            return DiagnosticSubFunctions[ i ].mName;
+
+    return NULL;
+}
+
+void ModbusFrameFormatter::AppendFields( ModbusTextBuffer& text, const Frame& frame, bool labels ) const
+{
+    U8 funccode = ( frame.mData1 >> 48 ) & 0xFF;
+
+    if( labels )
+        text.Append( "DeviceID: " );
+    AppendNumber( text, frame.mData1 >> 56 );
+
+    text.Append( labels ? ", Func: " : ", " );
+    AppendName( text, frame );
+    text.Append( " (" );
+    AppendNumber( text, funccode );
+    text.Append( ")" );
+
+    U32 field_count;
+    const ModbusTextField* fields = GetFields( frame, field_count );
+
+    for( U32 i = 0; i < field_count; i++ )
+    {
+        text.Append( ", " );
+        text.Append( fields[ i ].mLabel );
+        text.Append( ": " );
+
+        const char* name = fields[ i ].mNamed ? GetSubFunctionName( frame ) : NULL;
+        if( name != NULL )
+        {
+            text.Append( name );
+            text.Append( " (" );
+            AppendNumber( text, GetSlotValue( frame, fields[ i ].mSlot ) );
+            text.Append( ")" );
+        }
+        else
+        {
+            AppendNumber( text, GetSlotValue( frame, fields[ i ].mSlot ) );
+        }
+    }
+}
+
+void ModbusFrameFormatter::GetColumnValues( const Frame& frame, S32 values[ ColumnCount ] ) const
+{
+    for( U32 i = 0; i < ColumnCount; i++ )
+        values[ i ] = -1;
+
+    U32 field_count;
+    const ModbusTextField* fields = GetFields( frame, field_count );
+    for( U32 i = 0; i < field_count; i++ )
+        if( fields[ i ].mColumn != ColumnNone && values[ fields[ i ].mColumn ] < 0 )
+            values[ fields[ i ].mColumn ] = GetSlotValue( frame, fields[ i ].mSlot );
+}
+
+const ModbusTextField* ModbusFrameFormatter::GetFields( const Frame& frame, U32& field_count ) const
+{
+    if( frame.mFlags & FLAG_EXCEPTION_FRAME )
+    {
+        field_count = sizeof( Exception ) / sizeof( Exception[ 0 ] );
+        return Exception;
+    }
+
+    const ModbusFunctionText* function = FindFunction( ( frame.mData1 >> 48 ) & 0xFF );
+    if( frame.mFlags & FLAG_REQUEST_FRAME )
+    {
+        field_count = function->mRequestFieldCount;
+        return function->mRequestFields;
+    }
+
+    field_count = function->mResponseFieldCount;
+    return function->mResponseFields;
+}
+
+const ModbusFunctionText* ModbusFrameFormatter::FindFunction( U8 funccode ) const
+{
+    return gFunctionTextsByCode.mTexts[ funccode ];
+}
@@ -0,0 +1,112 @@
+#ifndef MODBUS_FRAME_FORMATTER
+#define MODBUS_FRAME_FORMATTER
+
+#include <AnalyzerResults.h>
+#include <LogicPublicTypes.h>
+
+// big enough for a whole ADU's worth of values, file record sub-requests included
+#define MODBUS_TEXT_SIZE 4096
+
+// The fields that get a column of their own in the columnar export; ColumnNone for the rest.
+enum ModbusTextColumn
+{
+    ColumnNone,
+    ColumnStartAddress,
+    ColumnQuantity,
+    ColumnByteCount,
+    ColumnExceptionCode,
+    ColumnCount
+};
+
+// What the text of a Modbus frame shows for one direction of a function code: the fixed fields, in order, and the label of each.
+// ModbusFrameFormatter walks these, so the bubbles, the data table and the export all describe a frame the same way.
+struct ModbusTextField
+{
+    const char* mLabel;
+    U8 mSlot;   // a ModbusPduEnums::Slot; SlotLength stands for the low word of mData1, checksum or length
+    bool mNamed; // shown as the sub-function's name followed by its value
+    U8 mColumn;  // a ModbusTextColumn
+};
+
+struct ModbusFunctionText
+{
+    U8 mFunctionCode;
+    const char* mName;
+    const ModbusTextField* mRequestFields;
+    U32 mRequestFieldCount;
+    const ModbusTextField* mResponseFields;
+    U32 mResponseFieldCount;
+};
+
+struct ModbusSubFunctionText
+{
+    U16 mSubFunction;
+    const char* mName;
+};
+
+// Every function code with a name of its own. Anything else is a user defined function, shown without fields.
+extern const ModbusFunctionText gModbusFunctionTexts[];
+extern const U32 gModbusFunctionTextCount;
+
+// Appends to a caller's fixed size buffer, keeping it terminated; whatever doesn't fit is dropped.
+class ModbusTextBuffer
+{
+  public:
+    ModbusTextBuffer( char* buffer, U32 size );
+
+    void Append( const char* str );
+    void Append( const char* str, U32 length );
+    void Clear();
+
+    const char* GetText() const;
+    U32 GetLength() const;
+
+  protected:
+    char* mBuffer;
+    U32 mSize;
+    U32 mLength;
+};
+
+// Writes the text of Modbus mode frames in one display base. Hex and decimal numbers are written directly; any other base goes
+// through AnalyzerHelpers::GetNumberString().
+class ModbusFrameFormatter
+{
+  public:
+    ModbusFrameFormatter( DisplayBase display_base, U32 bits_per_transfer );
+
+    void AppendNumber( ModbusTextBuffer& text, U64 value, U32 bits ) const;
+    void AppendNumber( ModbusTextBuffer& text, U64 value ) const; // at bits_per_transfer
+
+    // "1.234567890", seconds from the trigger. Unlike AnalyzerHelpers::GetTimeString() it only writes to the text it is given,
+    // so any number of threads can use it at once.
+    static void AppendTime( ModbusTextBuffer& text, U64 sample, U64 trigger_sample, U32 sample_rate );
+
+    // whether this formatter can be used from several threads at once: it is, unless the display base needs
+    // AnalyzerHelpers::GetNumberString()
+    bool IsReentrant() const;
+
+    // "Read Coils [ACK]", "Diagnostics [NACK]"
+    void AppendName( ModbusTextBuffer& text, const Frame& frame ) const;
+    // the name of a diagnostics sub-function, or NULL
+    const char* GetSubFunctionName( const Frame& frame ) const;
+
+    // "DeviceID: 0x01, Func: Read Coils (0x01), StartAddr: 0x0000, Qty: 0x000A, ChkSum: 0xCDC5". Without labels the device and
+    // function are left bare ("0x01, Read Coils (0x01), StartAddr: ..."), as they go in columns of their own in the export.
+    void AppendFields( ModbusTextBuffer& text, const Frame& frame, bool labels ) const;
+
+    // the values of the fields with a column of their own, by ModbusTextColumn; -1 for those the frame doesn't have
+    void GetColumnValues( const Frame& frame, S32 values[ ColumnCount ] ) const;
+
+    // the value of a fixed field, by its ModbusPduEnums::Slot
+    static U16 GetSlotValue( const Frame& frame, U8 slot );
+
+  protected:
+    const ModbusFunctionText* FindFunction( U8 funccode ) const;
+    // the fixed fields of the frame's function, in the frame's direction
+    const ModbusTextField* GetFields( const Frame& frame, U32& field_count ) const;
+
+    DisplayBase mDisplayBase;
+    U32 mBitsPerTransfer;
+};
+
+#endif // MODBUS_FRAME_FORMATTER
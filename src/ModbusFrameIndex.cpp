@@ -0,0 +1,334 @@
+#include "ModbusFrameIndex.h"
+
+#include <algorithm>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+ModbusFrameQuery::ModbusFrameQuery() : mErrors( 0 ), mFromTime( -DBL_MAX ), mToTime( DBL_MAX )
+{
+}
+
+bool ModbusFrameQuery::UsesIndex() const
+{
+    return !mDevAddrs.empty() || !mFuncCodes.empty() || mErrors != 0;
+}
+
+// "17,0x12"
+static bool ParseQueryNumbers( const std::string& value, U32 max, std::vector<U8>& numbers )
+{
+    size_t start = 0;
+    for( ;; )
+    {
+        size_t end = value.find( ',', start );
+        if( end == std::string::npos )
+            end = value.size();
+
+        std::string number = value.substr( start, end - start );
+        char* number_end;
+        unsigned long parsed = strtoul( number.c_str(), &number_end, 0 );
+        if( number.empty() || *number_end != '\0' || parsed > max )
+            return false;
+        numbers.push_back( U8( parsed ) );
+
+        if( end == value.size() )
+            return true;
+        start = end + 1;
+    }
+}
+
+static bool ParseQueryTime( const std::string& value, double& seconds )
+{
+    char* end;
+    seconds = strtod( value.c_str(), &end );
+    return !value.empty() && *end == '\0';
+}
+
+bool ParseModbusFrameQuery( const char* text, ModbusFrameQuery& query, std::string& error )
+{
+    using namespace ModbusFrameIndexEnums;
+
+    query = ModbusFrameQuery();
+
+    std::string words( text );
+    for( U32 i = 0; i < words.size(); i++ )
+        if( words[ i ] == '\t' )
+            words[ i ] = ' ';
+
+    size_t start = 0;
+    while( ( start = words.find_first_not_of( ' ', start ) ) != std::string::npos )
+    {
+        size_t end = words.find( ' ', start );
+        if( end == std::string::npos )
+            end = words.size();
+        std::string word = words.substr( start, end - start );
+        start = end;
+
+        size_t equals = word.find( '=' );
+        if( equals != std::string::npos )
+        {
+            std::string name = word.substr( 0, equals );
+            std::string value = word.substr( equals + 1 );
+
+            if( name == "device" )
+            {
+                if( !ParseQueryNumbers( value, 0xFF, query.mDevAddrs ) )
+                {
+                    error = "The export filter's devices must be numbers from 0 to 255, separated by commas.";
+                    return false;
+                }
+            }
+            else if( name == "function" )
+            {
+                if( !ParseQueryNumbers( value, 0x7F, query.mFuncCodes ) )
+                {
+                    error = "The export filter's functions must be numbers from 0 to 127, separated by commas.";
+                    return false;
+                }
+            }
+            else if( name == "from" || name == "to" )
+            {
+                if( !ParseQueryTime( value, name == "from" ? query.mFromTime : query.mToTime ) )
+                {
+                    error = "The export filter's from= and to= must be times in seconds.";
+                    return false;
+                }
+            }
+            else
+            {
+                error = "The export filter doesn't know \"" + name + "=\"; use device=, function=, from= and to=.";
+                return false;
+            }
+            continue;
+        }
+
+        // error kinds may also be run together with commas
+        size_t kind_start = 0;
+        for( ;; )
+        {
+            size_t kind_end = word.find( ',', kind_start );
+            if( kind_end == std::string::npos )
+                kind_end = word.size();
+            std::string kind = word.substr( kind_start, kind_end - kind_start );
+
+            if( kind == "exceptions" )
+                query.mErrors |= ErrorException;
+            else if( kind == "checksum" )
+                query.mErrors |= ErrorChecksum;
+            else if( kind == "truncated" )
+                query.mErrors |= ErrorTruncated;
+            else if( kind == "line" )
+                query.mErrors |= ErrorLine;
+            else if( kind == "errors" )
+                query.mErrors |= ErrorAny;
+            else if( !kind.empty() )
+            {
+                error = "The export filter doesn't know \"" + kind + "\"; use exceptions, checksum, truncated, line or errors.";
+                return false;
+            }
+
+            if( kind_end == word.size() )
+                break;
+            kind_start = kind_end + 1;
+        }
+    }
+
+    if( query.mFromTime > query.mToTime )
+    {
+        error = "The export filter's from= time is after its to= time.";
+        return false;
+    }
+
+    return true;
+}
+
+ModbusFrameIndex::PostingList::PostingList() : mCount( 0 ), mLast( 0 )
+{
+}
+
+void ModbusFrameIndex::PostingList::Add( U64 frame_index )
+{
+    // the first gap is from frame 0
+    U64 gap = frame_index - mLast;
+    if( mCount == 0 )
+        gap = frame_index;
+
+    // seven bits at a time, low first, with the top bit set on all but the last byte
+    while( gap >= 0x80 )
+    {
+        mGaps.push_back( U8( gap | 0x80 ) );
+        gap >>= 7;
+    }
+    mGaps.push_back( U8( gap ) );
+
+    if( mCount % kSkipInterval == 0 )
+    {
+        Skip skip;
+        skip.mFrameIndex = frame_index;
+        skip.mOffset = mGaps.size();
+        mSkips.push_back( skip );
+    }
+
+    mLast = frame_index;
+    mCount++;
+}
+
+ModbusFrameIndex::Cursor::Cursor( const PostingList& list ) : mList( &list ), mIndex( 0 ), mOffset( 0 ), mFrameIndex( 0 )
+{
+    Next();
+}
+
+void ModbusFrameIndex::Cursor::Next()
+{
+    if( mIndex == mList->mCount )
+    {
+        mFrameIndex = kEnd;
+        return;
+    }
+
+    const U8* gaps = mList->mGaps.data();
+    U64 gap = 0;
+    U32 shift = 0;
+    for( ;; )
+    {
+        U8 byte = gaps[ mOffset++ ];
+        gap |= U64( byte & 0x7F ) << shift;
+        if( ( byte & 0x80 ) == 0 )
+            break;
+        shift += 7;
+    }
+
+    mFrameIndex += gap;
+    mIndex++;
+}
+
+bool ModbusFrameIndex::Skip::ComesAfter( U64 frame_index, const Skip& skip )
+{
+    return frame_index < skip.mFrameIndex;
+}
+
+U64 ModbusFrameIndex::Cursor::Seek( U64 frame_index )
+{
+    if( mFrameIndex >= frame_index )
+        return mFrameIndex;
+
+    // If the frame index is past the next skip entry, jump to the last one at or before it, so at most kSkipInterval gaps are
+    // decoded to get there. Nearer than that, as when intersecting dense lists, decoding is cheaper than searching.
+    const std::vector<Skip>& skips = mList->mSkips;
+    U64 next_skip = ( mIndex + kSkipInterval - 1 ) / kSkipInterval;
+    if( next_skip < skips.size() && skips[ next_skip ].mFrameIndex <= frame_index )
+    {
+        U64 skip = std::upper_bound( skips.begin() + next_skip, skips.end(), frame_index, Skip::ComesAfter ) - skips.begin() - 1;
+        mIndex = skip * kSkipInterval + 1;
+        mOffset = skips[ skip ].mOffset;
+        mFrameIndex = skips[ skip ].mFrameIndex;
+    }
+
+    while( mFrameIndex < frame_index )
+        Next();
+    return mFrameIndex;
+}
+
+ModbusFrameIndex::ModbusFrameIndex()
+{
+}
+
+void ModbusFrameIndex::Add( U64 frame_index, U8 devaddr, U8 funccode, U32 errors )
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+
+    mDevices[ devaddr ].Add( frame_index );
+    mFunctions[ funccode & 0x7F ].Add( frame_index );
+
+    for( U32 i = 0; i < kErrorKinds; i++ )
+        if( errors & ( 1 << i ) )
+            mErrors[ i ].Add( frame_index );
+}
+
+void ModbusFrameIndex::Find( const ModbusFrameQuery& query, U64 first_frame, U64 end_frame, std::vector<U64>& frame_indexes ) const
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+
+    frame_indexes.clear();
+
+    // a frame has to be on one of the lists of each group the query names
+    std::vector<std::vector<Cursor> > groups;
+    std::vector<U64> sizes;
+
+    if( !query.mDevAddrs.empty() )
+    {
+        groups.push_back( std::vector<Cursor>() );
+        sizes.push_back( 0 );
+        for( U32 i = 0; i < query.mDevAddrs.size(); i++ )
+        {
+            groups.back().push_back( Cursor( mDevices[ query.mDevAddrs[ i ] ] ) );
+            sizes.back() += mDevices[ query.mDevAddrs[ i ] ].mCount;
+        }
+    }
+
+    if( !query.mFuncCodes.empty() )
+    {
+        groups.push_back( std::vector<Cursor>() );
+        sizes.push_back( 0 );
+        for( U32 i = 0; i < query.mFuncCodes.size(); i++ )
+        {
+            groups.back().push_back( Cursor( mFunctions[ query.mFuncCodes[ i ] & 0x7F ] ) );
+            sizes.back() += mFunctions[ query.mFuncCodes[ i ] & 0x7F ].mCount;
+        }
+    }
+
+    if( query.mErrors != 0 )
+    {
+        groups.push_back( std::vector<Cursor>() );
+        sizes.push_back( 0 );
+        for( U32 i = 0; i < kErrorKinds; i++ )
+        {
+            if( query.mErrors & ( 1 << i ) )
+            {
+                groups.back().push_back( Cursor( mErrors[ i ] ) );
+                sizes.back() += mErrors[ i ].mCount;
+            }
+        }
+    }
+
+    // nothing to narrow the range down with
+    if( groups.empty() )
+    {
+        for( U64 frame_index = first_frame; frame_index < end_frame; frame_index++ )
+            frame_indexes.push_back( frame_index );
+        return;
+    }
+
+    // The group with the fewest frames puts forward each candidate, and the others are asked for it. A group that doesn't have it
+    // answers with the next frame it does have, and the smallest group skips ahead to that. So the work goes by the smallest group,
+    // not by the others' sizes.
+    U32 smallest = U32( std::min_element( sizes.begin(), sizes.end() ) - sizes.begin() );
+    U64 candidate = SeekUnion( groups[ smallest ], first_frame );
+    while( candidate < end_frame )
+    {
+        U64 next = candidate;
+        for( U32 i = 0; i < groups.size() && next == candidate; i++ )
+            if( i != smallest )
+                next = SeekUnion( groups[ i ], candidate );
+
+        if( next == kEnd )
+            break;
+
+        if( next == candidate )
+        {
+            frame_indexes.push_back( candidate );
+            next = candidate + 1;
+        }
+
+        candidate = SeekUnion( groups[ smallest ], next );
+    }
+}
+
+U64 ModbusFrameIndex::SeekUnion( std::vector<Cursor>& cursors, U64 frame_index )
+{
+    // a frame on more than one of the lists (which only error lists can share) still only comes up once
+    U64 lowest = kEnd;
+    for( U32 i = 0; i < cursors.size(); i++ )
+        lowest = std::min( lowest, cursors[ i ].Seek( frame_index ) );
+    return lowest;
+}
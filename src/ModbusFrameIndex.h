@@ -0,0 +1,115 @@
+#ifndef MODBUS_FRAME_INDEX
+#define MODBUS_FRAME_INDEX
+
+#include <LogicPublicTypes.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ModbusFrameIndexEnums
+{
+    // what can go wrong with an ADU, as a mask
+    enum Error
+    {
+        ErrorException = 1 << 0,
+        ErrorChecksum = 1 << 1,
+        ErrorTruncated = 1 << 2,
+        ErrorLine = 1 << 3, // parity or framing errors in any of its characters
+        ErrorAny = ( 1 << 4 ) - 1
+    };
+}
+
+// Which frames to look for. Each part left at its default matches every frame.
+struct ModbusFrameQuery
+{
+    ModbusFrameQuery();
+
+    // whether Find() has anything to do, rather than every frame in the time range matching
+    bool UsesIndex() const;
+
+    std::vector<U8> mDevAddrs;  // any of these; empty for any device
+    std::vector<U8> mFuncCodes; // any of these; empty for any. Exceptions count under the function they answer
+    U32 mErrors;                // frames with any of these ModbusFrameIndexEnums::Error; 0 for any frame, with or without errors
+
+    // seconds from the trigger, as in the exports' time column; frames that start within [ mFromTime, mToTime ]
+    double mFromTime;
+    double mToTime;
+};
+
+// "device=17,18 function=0x10 from=12.5 to=15 errors". Words are device= and function= with one or more numbers, from= and
+// to= in seconds, and the error kinds exceptions, checksum, truncated, line and errors (any of them). Returns false, with a
+// message, on anything it doesn't understand.
+bool ParseModbusFrameQuery( const char* text, ModbusFrameQuery& query, std::string& error );
+
+// Frame indexes by device, function code and error, kept as the analyzer adds frames so that looking frames up never means
+// formatting them. Each list holds the gaps between consecutive frame indexes as variable length integers, which mostly takes a
+// single byte per frame, and every kSkipInterval-th frame index with where it ends in the gaps, so a lookup in a late time range
+// starts near it rather than at the head of each list.
+class ModbusFrameIndex
+{
+  public:
+    ModbusFrameIndex();
+
+    // analyzer thread, with increasing frame indexes
+    void Add( U64 frame_index, U8 devaddr, U8 funccode, U32 errors );
+
+    // any thread; the frames from first_frame up to end_frame that match the query's devices, function codes and errors, in order
+    void Find( const ModbusFrameQuery& query, U64 first_frame, U64 end_frame, std::vector<U64>& frame_indexes ) const;
+
+  protected:
+    struct Skip
+    {
+        static bool ComesAfter( U64 frame_index, const Skip& skip ); // for std::upper_bound()
+
+        U64 mFrameIndex;
+        U64 mOffset; // of the gap after it
+    };
+
+    struct PostingList
+    {
+        PostingList();
+
+        void Add( U64 frame_index );
+
+        std::vector<U8> mGaps;
+        std::vector<Skip> mSkips; // postings 0, kSkipInterval, 2 * kSkipInterval...
+        U64 mCount;
+        U64 mLast;
+    };
+
+    // Walks a list in order. Seek() only ever moves forward, and leaves the cursor on the first frame index at or after the one
+    // asked for.
+    class Cursor
+    {
+      public:
+        Cursor( const PostingList& list );
+
+        U64 Seek( U64 frame_index ); // the frame index it lands on; kEnd once the list runs out
+
+      protected:
+        void Next();
+
+        const PostingList* mList;
+        U64 mIndex; // postings decoded so far
+        U64 mOffset;
+        U64 mFrameIndex;
+    };
+
+    enum
+    {
+        kErrorKinds = 4,
+        kSkipInterval = 128
+    };
+
+    static const U64 kEnd = ~0ULL;
+
+    // the lowest frame index at or after frame_index on any of the cursors' lists
+    static U64 SeekUnion( std::vector<Cursor>& cursors, U64 frame_index );
+
+    mutable std::mutex mMutex;
+    PostingList mDevices[ 256 ];
+    PostingList mFunctions[ 128 ];
+    PostingList mErrors[ kErrorKinds ];
+};
+
+#endif // MODBUS_FRAME_INDEX
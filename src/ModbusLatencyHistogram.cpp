@@ -0,0 +1,115 @@
+#include "ModbusLatencyHistogram.h"
+
+namespace
+{
+    const U32 kSubBucketBits = 5;
+    const U32 kSubBucketCount = 1 << kSubBucketBits;
+    const U32 kTopMagnitude = 27; // values from 2^27 up are clamped
+    const U32 kBucketCount = kSubBucketCount + ( kTopMagnitude - kSubBucketBits ) * kSubBucketCount;
+}
+
+ModbusLatencyHistogram::ModbusLatencyHistogram()
+{
+    Reset();
+}
+
+void ModbusLatencyHistogram::Reset()
+{
+    std::vector<U64>().swap( mBuckets );
+    mCount = 0;
+    mSum = 0;
+    mMin = 0;
+    mMax = 0;
+}
+
+void ModbusLatencyHistogram::Add( U64 microseconds )
+{
+    if( mBuckets.empty() )
+        mBuckets.resize( kBucketCount, 0 );
+
+    mBuckets[ BucketOf( microseconds ) ]++;
+
+    if( mCount == 0 || microseconds < mMin )
+        mMin = microseconds;
+    if( microseconds > mMax )
+        mMax = microseconds;
+
+    mCount++;
+    mSum += microseconds;
+}
+
+U64 ModbusLatencyHistogram::GetCount() const
+{
+    return mCount;
+}
+
+U64 ModbusLatencyHistogram::GetMin() const
+{
+    return mMin;
+}
+
+U64 ModbusLatencyHistogram::GetMax() const
+{
+    return mMax;
+}
+
+double ModbusLatencyHistogram::GetMean() const
+{
+    if( mCount == 0 )
+        return 0.0;
+
+    return double( mSum ) / double( mCount );
+}
+
+U64 ModbusLatencyHistogram::GetPercentile( double percentile ) const
+{
+    if( mCount == 0 )
+        return 0;
+
+    // the value with this many values at or below it
+    U64 rank = U64( percentile / 100.0 * mCount + 0.5 );
+    if( rank < 1 )
+        rank = 1;
+    if( rank > mCount )
+        rank = mCount;
+
+    U64 seen = 0;
+    for( U32 bucket = 0; bucket < kBucketCount; bucket++ )
+    {
+        seen += mBuckets[ bucket ];
+        if( seen >= rank )
+        {
+            U64 value = HighestValueIn( bucket );
+            return value < mMax ? value : mMax;
+        }
+    }
+
+    return mMax;
+}
+
+U32 ModbusLatencyHistogram::BucketOf( U64 value )
+{
+    if( value < kSubBucketCount )
+        return U32( value );
+
+    if( value >= ( U64( 1 ) << kTopMagnitude ) )
+        return kBucketCount - 1;
+
+    // the top kSubBucketBits bits of the value pick the bucket within its power of two
+    U32 magnitude = kSubBucketBits;
+    while( ( value >> ( magnitude + 1 ) ) != 0 )
+        magnitude++;
+
+    U32 shift = magnitude - kSubBucketBits;
+    return kSubBucketCount + shift * kSubBucketCount + U32( value >> shift ) - kSubBucketCount;
+}
+
+U64 ModbusLatencyHistogram::HighestValueIn( U32 bucket )
+{
+    if( bucket < kSubBucketCount )
+        return bucket;
+
+    U32 shift = ( bucket - kSubBucketCount ) / kSubBucketCount;
+    U64 sub_bucket = kSubBucketCount + ( bucket - kSubBucketCount ) % kSubBucketCount;
+    return ( ( sub_bucket + 1 ) << shift ) - 1;
+}
@@ -0,0 +1,37 @@
+#ifndef MODBUS_LATENCY_HISTOGRAM
+#define MODBUS_LATENCY_HISTOGRAM
+
+#include <LogicPublicTypes.h>
+#include <vector>
+
+// Response times in microseconds, in log-linear buckets (the HdrHistogram layout): one bucket per microsecond below 32us, then 32
+// buckets per power of two, so a percentile is never off by more than 1/32 (about 3%). Everything from 2^27us (over two minutes) up
+// lands in the top bucket. The buckets are only allocated once the first value comes in, and never grow after that.
+class ModbusLatencyHistogram
+{
+  public:
+    ModbusLatencyHistogram();
+
+    void Reset();
+    void Add( U64 microseconds );
+
+    U64 GetCount() const;
+    U64 GetMin() const;
+    U64 GetMax() const;
+    double GetMean() const;
+
+    // the highest value in the bucket the percentile (0 to 100) falls in, capped at the largest value seen
+    U64 GetPercentile( double percentile ) const;
+
+  protected:
+    static U32 BucketOf( U64 value );
+    static U64 HighestValueIn( U32 bucket );
+
+    std::vector<U64> mBuckets;
+    U64 mCount;
+    U64 mSum;
+    U64 mMin;
+    U64 mMax;
+};
+
+#endif // MODBUS_LATENCY_HISTOGRAM
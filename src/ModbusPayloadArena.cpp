@@ -0,0 +1,85 @@
+#include "ModbusPayloadArena.h"
+
+#include <string.h>
+
+ModbusPayloadArena::ModbusPayloadArena() : mByteBlockCount( 0 ), mByteBlockUsed( kByteBlockSize ), mEntryCount( 0 )
+{
+    memset( mByteBlocks, 0, sizeof( mByteBlocks ) );
+    memset( mEntryBlocks, 0, sizeof( mEntryBlocks ) );
+}
+
+ModbusPayloadArena::~ModbusPayloadArena()
+{
+    for( U32 i = 0; i < kMaxBlocks; i++ )
+    {
+        delete[] mByteBlocks[ i ];
+        delete[] mEntryBlocks[ i ];
+    }
+}
+
+void ModbusPayloadArena::Add( U64 frame_index, const U8* data, U32 length )
+{
+    if( length == 0 || length > kByteBlockSize )
+        return;
+
+    // start a new block rather than split the payload
+    if( mByteBlockUsed + length > kByteBlockSize )
+    {
+        if( mByteBlockCount == kMaxBlocks )
+            return;
+
+        mByteBlocks[ mByteBlockCount++ ] = new U8[ kByteBlockSize ];
+        mByteBlockUsed = 0;
+    }
+
+    U64 entry_index = mEntryCount.load( std::memory_order_relaxed );
+    U64 entry_block = entry_index >> kEntryBlockBits;
+    if( entry_block == kMaxBlocks )
+        return;
+
+    if( mEntryBlocks[ entry_block ] == NULL )
+        mEntryBlocks[ entry_block ] = new Entry[ kEntryBlockSize ];
+
+    U8* copy = mByteBlocks[ mByteBlockCount - 1 ] + mByteBlockUsed;
+    memcpy( copy, data, length );
+    mByteBlockUsed += length;
+
+    Entry& entry = mEntryBlocks[ entry_block ][ entry_index & ( kEntryBlockSize - 1 ) ];
+    entry.mFrameIndex = frame_index;
+    entry.mData = copy;
+    entry.mLength = length;
+
+    // publish the entry, and the bytes it points to, in one go
+    mEntryCount.store( entry_index + 1, std::memory_order_release );
+}
+
+U32 ModbusPayloadArena::Get( U64 frame_index, const U8*& data ) const
+{
+    // entries are in frame order, but not every frame has one
+    U64 low = 0;
+    U64 high = mEntryCount.load( std::memory_order_acquire );
+
+    while( low < high )
+    {
+        U64 middle = low + ( high - low ) / 2;
+        const Entry& entry = EntryAt( middle );
+
+        if( entry.mFrameIndex == frame_index )
+        {
+            data = entry.mData;
+            return entry.mLength;
+        }
+
+        if( entry.mFrameIndex < frame_index )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return 0;
+}
+
+const ModbusPayloadArena::Entry& ModbusPayloadArena::EntryAt( U64 index ) const
+{
+    return mEntryBlocks[ index >> kEntryBlockBits ][ index & ( kEntryBlockSize - 1 ) ];
+}
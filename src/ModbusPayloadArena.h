@@ -0,0 +1,50 @@
+#ifndef MODBUS_PAYLOAD_ARENA
+#define MODBUS_PAYLOAD_ARENA
+
+#include <LogicPublicTypes.h>
+#include <atomic>
+
+// Append-only store for the bytes of ADUs that don't fit in a Frame, looked up by frame index.
+//
+// The analyzer thread appends while the GUI reads back, so nothing ever moves: bytes and index entries live in fixed size blocks
+// that are allocated as needed and kept until the arena is destroyed, and an entry only becomes visible once it is complete.
+// A payload never straddles two blocks. Once the block tables are full, further payloads are dropped.
+class ModbusPayloadArena
+{
+  public:
+    ModbusPayloadArena();
+    ~ModbusPayloadArena();
+
+    // analyzer thread only, with increasing frame indexes, before the frame is committed
+    void Add( U64 frame_index, const U8* data, U32 length );
+
+    // any thread; returns 0 (and leaves data alone) for a frame without a payload
+    U32 Get( U64 frame_index, const U8*& data ) const;
+
+  protected:
+    struct Entry
+    {
+        U64 mFrameIndex;
+        U8* mData;
+        U32 mLength;
+    };
+
+    enum
+    {
+        kByteBlockSize = 1 << 20,
+        kEntryBlockBits = 16,
+        kEntryBlockSize = 1 << kEntryBlockBits,
+        kMaxBlocks = 1 << 14
+    };
+
+    const Entry& EntryAt( U64 index ) const;
+
+    U8* mByteBlocks[ kMaxBlocks ];
+    U32 mByteBlockCount;
+    U32 mByteBlockUsed; // in the last block
+
+    Entry* mEntryBlocks[ kMaxBlocks ];
+    std::atomic<U64> mEntryCount;
+};
+
+#endif // MODBUS_PAYLOAD_ARENA
@@ -0,0 +1,27 @@
+#ifndef MODBUS_PCAPNG_EXPORT
+#define MODBUS_PCAPNG_EXPORT
+
+#include "ModbusBinaryExport.h"
+
+// The pcapng export: a section header, one interface, then an enhanced packet block per ADU, all little-endian. Each packet is
+// the ADU as it went over the line, address to checksum (ASCII ADUs as the bytes their hex digits stand for, LRC last), under
+// the LINKTYPE_USER0 link type. In Wireshark, map User 0 to the "mbrtu" protocol under Preferences > Protocols > DLT_USER.
+//
+// Timestamps are in nanoseconds from the start of the capture. Requests are marked outbound and responses inbound, as seen
+// from the client.
+
+#define PCAPNG_BLOCK_SECTION_HEADER 0x0A0D0D0A
+#define PCAPNG_BLOCK_INTERFACE_DESCRIPTION 0x00000001
+#define PCAPNG_BLOCK_ENHANCED_PACKET 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+
+#define PCAPNG_OPTION_END 0
+#define PCAPNG_OPTION_IF_TSRESOL 9
+#define PCAPNG_OPTION_EPB_FLAGS 2
+
+#define PCAPNG_EPB_FLAGS_INBOUND 1
+#define PCAPNG_EPB_FLAGS_OUTBOUND 2
+
+#define PCAPNG_LINKTYPE_USER0 147
+
+#endif // MODBUS_PCAPNG_EXPORT
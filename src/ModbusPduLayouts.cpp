@@ -0,0 +1,93 @@
+#include "ModbusPduLayouts.h"
+#include "ModbusAnalyzerModbusExtension.h"
+
+#include <stddef.h>
+
+using namespace ModbusPduEnums;
+
+#define PDU_FIELDS( fields ) fields, sizeof( fields ) / sizeof( fields[ 0 ] )
+#define PDU_NO_FIELDS NULL, 0
+
+// Fixed fields
+static const ModbusPduField AddressAndValue[] = { { SlotPayload1, 2 }, { SlotPayload2, 2 } };
+static const ModbusPduField AddressValueAndByteCount[] = { { SlotPayload1, 2 }, { SlotPayload2, 2 }, { SlotLength, 1 } };
+static const ModbusPduField ByteCount[] = { { SlotLength, 1 } };
+static const ModbusPduField SingleByte[] = { { SlotPayload1, 1 } };
+static const ModbusPduField Address[] = { { SlotPayload1, 2 } };
+static const ModbusPduField MaskWrite[] = { { SlotPayload1, 2 }, { SlotPayload2, 2 }, { SlotPayload3, 2 } };
+static const ModbusPduField ReadWriteMultiple[] = {
+    { SlotPayload1, 2 }, { SlotPayload2, 2 }, { SlotPayload4, 2 }, { SlotPayload3, 2 }, { SlotLength, 1 }
+};
+static const ModbusPduField ComEventLog[] = { { SlotLength, 1 }, { SlotPayload1, 2 }, { SlotPayload4, 2 }, { SlotPayload3, 2 } };
+static const ModbusPduField FifoQueue[] = { { SlotLength, 2 }, { SlotPayload2, 2 } };
+static const ModbusPduField FileSubRequest[] = { { SlotFunctionCode, 1 }, { SlotPayload1, 2 }, { SlotPayload2, 2 }, { SlotLength, 2 } };
+static const ModbusPduField FileSubResponse[] = { { SlotLength, 1 }, { SlotFunctionCode, 1 } };
+static const ModbusPduField DeviceIdRequest[] = { { SlotPayload1, 1 }, { SlotPayload2, 1 }, { SlotPayload3, 1 } };
+static const ModbusPduField DeviceIdResponse[] = { { SlotPayload1, 1 }, { SlotPayload2, 1 } };
+
+// File record groups
+static const ModbusPduLayout ReadFileSubRequest = { PDU_FIELDS( FileSubRequest ), NoBody, 0, 0, NULL };
+static const ModbusPduLayout WriteFileSubRequest = { PDU_FIELDS( FileSubRequest ), Registers, 2, 0, NULL };
+static const ModbusPduLayout ReadFileSubResponse = { PDU_FIELDS( FileSubResponse ), Registers, 1, 1, NULL }; // length covers ref type
+
+// Requests
+static const ModbusPduLayout AddressAndValueRequest = { PDU_FIELDS( AddressAndValue ), NoBody, 0, 0, NULL };
+static const ModbusPduLayout EmptyRequest = { PDU_NO_FIELDS, NoBody, 0, 0, NULL };
+static const ModbusPduLayout WriteMultipleCoilsRequest = { PDU_FIELDS( AddressValueAndByteCount ), Bytes, 1, 0, NULL };
+static const ModbusPduLayout WriteMultipleRegistersRequest = { PDU_FIELDS( AddressValueAndByteCount ), Registers, 1, 0, NULL };
+static const ModbusPduLayout ReadFileRecordRequest = { PDU_FIELDS( ByteCount ), Groups, 1, 0, &ReadFileSubRequest };
+static const ModbusPduLayout WriteFileRecord = { PDU_FIELDS( ByteCount ), Groups, 1, 0, &WriteFileSubRequest };
+static const ModbusPduLayout MaskWriteRegister = { PDU_FIELDS( MaskWrite ), NoBody, 0, 0, NULL };
+static const ModbusPduLayout ReadWriteMultipleRequest = { PDU_FIELDS( ReadWriteMultiple ), Registers, 1, 0, NULL };
+static const ModbusPduLayout ReadFifoQueueRequest = { PDU_FIELDS( Address ), NoBody, 0, 0, NULL };
+static const ModbusPduLayout ReadDeviceIdRequest = { PDU_FIELDS( DeviceIdRequest ), NoBody, 0, 0, NULL };
+
+// Responses
+static const ModbusPduLayout ByteDataResponse = { PDU_FIELDS( ByteCount ), Bytes, 1, 0, NULL };
+static const ModbusPduLayout RegisterDataResponse = { PDU_FIELDS( ByteCount ), Registers, 1, 0, NULL };
+static const ModbusPduLayout AddressAndValueResponse = { PDU_FIELDS( AddressAndValue ), NoBody, 0, 0, NULL };
+static const ModbusPduLayout ExceptionStatusResponse = { PDU_FIELDS( SingleByte ), NoBody, 0, 0, NULL };
+static const ModbusPduLayout ComEventLogResponse = { PDU_FIELDS( ComEventLog ), Bytes, 1, 6, NULL }; // byte count covers the 3 words
+static const ModbusPduLayout ReadFileRecordResponse = { PDU_FIELDS( ByteCount ), Groups, 1, 0, &ReadFileSubResponse };
+static const ModbusPduLayout ReadFifoQueueResponse = { PDU_FIELDS( FifoQueue ), Registers, 1, 2, NULL }; // byte count covers FIFO count
+static const ModbusPduLayout ReadDeviceIdResponse = { PDU_FIELDS( DeviceIdResponse ), Bytes, 0, 0, NULL };
+
+const ModbusPduLayout gModbusExceptionLayout = { PDU_FIELDS( SingleByte ), NoBody, 0, 0, NULL };
+const ModbusPduLayout gModbusUnknownLayout = { PDU_NO_FIELDS, Bytes, 0, 0, NULL };
+
+const ModbusFunctionLayouts gModbusFunctionLayouts[] = {
+    { FUNCCODE_READ_COILS, &AddressAndValueRequest, &ByteDataResponse },
+    { FUNCCODE_READ_DISCRETE_INPUTS, &AddressAndValueRequest, &ByteDataResponse },
+    { FUNCCODE_READ_HOLDING_REGISTERS, &AddressAndValueRequest, &RegisterDataResponse },
+    { FUNCCODE_READ_INPUT_REGISTER, &AddressAndValueRequest, &RegisterDataResponse },
+    { FUNCCODE_WRITE_SINGLE_COIL, &AddressAndValueRequest, &AddressAndValueResponse },
+    { FUNCCODE_WRITE_SINGLE_REGISTER, &AddressAndValueRequest, &AddressAndValueResponse },
+    { FUNCCODE_READ_EXCEPTION_STATUS, &EmptyRequest, &ExceptionStatusResponse },
+    { FUNCCODE_DIAGNOSTIC, &AddressAndValueRequest, &AddressAndValueResponse },
+    { FUNCCODE_GET_COM_EVENT_COUNTER, &EmptyRequest, &AddressAndValueResponse },
+    { FUNCCODE_GET_COM_EVENT_LOG, &EmptyRequest, &ComEventLogResponse },
+    { FUNCCODE_WRITE_MULTIPLE_COILS, &WriteMultipleCoilsRequest, &AddressAndValueResponse },
+    { FUNCCODE_WRITE_MULTIPLE_REGISTERS, &WriteMultipleRegistersRequest, &AddressAndValueResponse },
+    { FUNCCODE_REPORT_SERVER_ID, &EmptyRequest, &ByteDataResponse },
+    { FUNCCODE_READ_FILE_RECORD, &ReadFileRecordRequest, &ReadFileRecordResponse },
+    { FUNCCODE_WRITE_FILE_RECORD, &WriteFileRecord, &WriteFileRecord },
+    { FUNCCODE_MASK_WRITE_REGISTER, &MaskWriteRegister, &MaskWriteRegister },
+    { FUNCCODE_READWRITE_MULTIPLE_REGISTERS, &ReadWriteMultipleRequest, &RegisterDataResponse },
+    { FUNCCODE_READ_FIFO_QUEUE, &ReadFifoQueueRequest, &ReadFifoQueueResponse },
+    { FUNCCODE_READ_DEVICE_ID, &ReadDeviceIdRequest, &ReadDeviceIdResponse },
+};
+
+const U32 gModbusFunctionLayoutCount = sizeof( gModbusFunctionLayouts ) / sizeof( gModbusFunctionLayouts[ 0 ] );
+
+const ModbusPduLayout& GetModbusPduLayout( U8 funccode, bool response )
+{
+    for( U32 i = 0; i < gModbusFunctionLayoutCount; i++ )
+        if( gModbusFunctionLayouts[ i ].mFunctionCode == funccode )
+            return response ? *gModbusFunctionLayouts[ i ].mResponse : *gModbusFunctionLayouts[ i ].mRequest;
+
+    // anything the table doesn't know is still walked byte by byte up to the checksum, so it can't throw off what follows
+    if( response && ( funccode & 0x80 ) )
+        return gModbusExceptionLayout;
+
+    return gModbusUnknownLayout;
+}
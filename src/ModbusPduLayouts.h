@@ -0,0 +1,67 @@
+#ifndef MODBUS_PDU_LAYOUTS
+#define MODBUS_PDU_LAYOUTS
+
+#include <LogicPublicTypes.h>
+
+// Describes how the bytes after the function code are laid out, so one small interpreter in ModbusAnalyzer can turn any PDU
+// into a frame, and ModbusAnalyzerResults can show the body kept in the frame's payload. A PDU is a run of fixed fields followed
+// by an optional body; the body is either plain data or a run of groups (the file record sub-requests) which are themselves laid
+// out the same way.
+namespace ModbusPduEnums
+{
+    // Where a field lands in the frame, matching what ModbusAnalyzerResults reads back
+    enum Slot
+    {
+        SlotFunctionCode, // mData1 bits 48-55 (used for the reference type of a sub-request)
+        SlotPayload1,     // mData1 bits 32-47
+        SlotPayload2,     // mData1 bits 16-31
+        SlotLength,       // mData1 bits 0-15, shared with the checksum; the value here sizes the body
+        SlotPayload3,     // mData2 bits 0-15
+        SlotPayload4      // mData2 bits 16-31
+    };
+
+    enum Body
+    {
+        NoBody,
+        Bytes,     // a run of byte values
+        Registers, // a run of 16 bit values
+        Groups     // a run of groups (the file record sub-requests), each followed by the group's own body
+    };
+}
+
+struct ModbusPduField
+{
+    U8 mSlot;
+    U8 mSize; // 1 or 2 bytes, big endian
+};
+
+struct ModbusPduLayout
+{
+    const ModbusPduField* mFields;
+    U32 mFieldCount;
+    U8 mBody;
+    // body length in bytes is ( length field * mLengthUnit ) - mLengthAdjust. Without a length field the body runs up to
+    // the checksum.
+    U8 mLengthUnit;
+    U8 mLengthAdjust;
+    const ModbusPduLayout* mGroup;
+};
+
+struct ModbusFunctionLayouts
+{
+    U8 mFunctionCode;
+    const ModbusPduLayout* mRequest;
+    const ModbusPduLayout* mResponse;
+};
+
+// Every function code the analyzer knows how to break down. Anything not listed here is shown with gModbusUnknownLayout.
+extern const ModbusFunctionLayouts gModbusFunctionLayouts[];
+extern const U32 gModbusFunctionLayoutCount;
+
+extern const ModbusPduLayout gModbusExceptionLayout;
+extern const ModbusPduLayout gModbusUnknownLayout;
+
+// the layout of one direction of a function, falling back on the exception and unknown layouts
+const ModbusPduLayout& GetModbusPduLayout( U8 funccode, bool response );
+
+#endif // MODBUS_PDU_LAYOUTS
@@ -0,0 +1,111 @@
+#include "ModbusPollingCycles.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    // FNV-1a
+    U64 HashBytes( U64 hash, const U8* data, U32 length )
+    {
+        for( U32 i = 0; i < length; i++ )
+        {
+            hash ^= data[ i ];
+            hash *= 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+}
+
+ModbusPollingCycles::ModbusPollingCycles()
+{
+    Reset();
+}
+
+void ModbusPollingCycles::Reset()
+{
+    memset( mCycles, 0, sizeof( mCycles ) );
+}
+
+void ModbusPollingCycles::AddRequest( U8 devaddr, U8 funccode, const U8* fields, U32 field_count, U64 starting_sample )
+{
+    if( field_count > MODBUS_POLLING_FIELD_BYTES )
+        field_count = MODBUS_POLLING_FIELD_BYTES;
+
+    U8 header[ 2 ] = { devaddr, funccode };
+    U64 signature = HashBytes( HashBytes( 0xCBF29CE484222325ull, header, 2 ), fields, field_count );
+    if( signature == 0 )
+        signature = 1;
+
+    // look for it in a short run of slots starting where the hash points; a new signature takes the first free slot there, or the
+    // one that has gone quiet the longest
+    U32 first_slot = U32( signature % MODBUS_POLLING_SIGNATURES );
+    ModbusPollingCycle* cycle = NULL;
+    ModbusPollingCycle* replace = NULL;
+
+    for( U32 i = 0; i < MODBUS_POLLING_PROBES; i++ )
+    {
+        ModbusPollingCycle& slot = mCycles[ ( first_slot + i ) % MODBUS_POLLING_SIGNATURES ];
+        if( slot.mSignature == signature )
+        {
+            cycle = &slot;
+            break;
+        }
+
+        if( replace == NULL || ( replace->mSignature != 0 && ( slot.mSignature == 0 || slot.mLastSample < replace->mLastSample ) ) )
+            replace = &slot;
+    }
+
+    if( cycle == NULL )
+    {
+        memset( replace, 0, sizeof( *replace ) );
+        replace->mSignature = signature;
+        replace->mDevAddr = devaddr;
+        replace->mFuncCode = funccode;
+        memcpy( replace->mFields, fields, field_count );
+        replace->mFieldCount = field_count;
+        replace->mPolls = 1;
+        replace->mLastSample = starting_sample;
+        return;
+    }
+
+    U64 interval = starting_sample - cycle->mLastSample;
+    cycle->mPolls++;
+    cycle->mLastSample = starting_sample;
+
+    // a poll that comes in more than half a period late means the ones in between never went out
+    if( cycle->mIntervals > 0 && interval > cycle->mMeanInterval * 1.5 )
+    {
+        cycle->mMissedPolls += U64( interval / cycle->mMeanInterval + 0.5 ) - 1;
+        return;
+    }
+
+    cycle->mIntervals++;
+    double delta = interval - cycle->mMeanInterval;
+    cycle->mMeanInterval += delta / cycle->mIntervals;
+    cycle->mIntervalM2 += delta * ( interval - cycle->mMeanInterval );
+
+    if( cycle->mIntervals == 1 || interval < cycle->mMinInterval )
+        cycle->mMinInterval = interval;
+    if( interval > cycle->mMaxInterval )
+        cycle->mMaxInterval = interval;
+}
+
+U32 ModbusPollingCycles::GetCycleCount() const
+{
+    return MODBUS_POLLING_SIGNATURES;
+}
+
+const ModbusPollingCycle& ModbusPollingCycles::GetCycle( U32 index ) const
+{
+    return mCycles[ index ];
+}
+
+double ModbusPollingCycles::GetJitter( const ModbusPollingCycle& cycle )
+{
+    if( cycle.mIntervals < 2 )
+        return 0.0;
+
+    return sqrt( cycle.mIntervalM2 / ( cycle.mIntervals - 1 ) );
+}
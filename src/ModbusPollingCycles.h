@@ -0,0 +1,55 @@
+#ifndef MODBUS_POLLING_CYCLES
+#define MODBUS_POLLING_CYCLES
+
+#include <LogicPublicTypes.h>
+
+// how many distinct requests are followed at once; once full, the one seen least recently makes room
+#define MODBUS_POLLING_SIGNATURES 512
+#define MODBUS_POLLING_PROBES 8
+// the fixed fields kept of each request, to tell the user which one it was (start address and quantity, mostly)
+#define MODBUS_POLLING_FIELD_BYTES 8
+
+// One request the client keeps sending: its timing so far. Intervals more than half a period late are counted as missed polls
+// rather than jitter.
+struct ModbusPollingCycle
+{
+    U64 mSignature; // 0 for a free slot
+    U8 mDevAddr;
+    U8 mFuncCode;
+    U8 mFields[ MODBUS_POLLING_FIELD_BYTES ];
+    U8 mFieldCount;
+
+    U64 mPolls;
+    U64 mMissedPolls;
+    U64 mLastSample;
+
+    // intervals in samples: count, running mean and sum of squared deviations (Welford), and extremes
+    U64 mIntervals;
+    double mMeanInterval;
+    double mIntervalM2;
+    U64 mMinInterval;
+    U64 mMaxInterval;
+};
+
+// Picks out requests that recur on a schedule: the same device, function and fixed fields (the address range, not the values
+// written). Works one request at a time in fixed memory.
+class ModbusPollingCycles
+{
+  public:
+    ModbusPollingCycles();
+
+    void Reset();
+
+    // fields are the request's fixed fields, without the body
+    void AddRequest( U8 devaddr, U8 funccode, const U8* fields, U32 field_count, U64 starting_sample );
+
+    U32 GetCycleCount() const; // slots, some of which may be free
+    const ModbusPollingCycle& GetCycle( U32 index ) const;
+
+    static double GetJitter( const ModbusPollingCycle& cycle ); // standard deviation of the interval, in samples
+
+  protected:
+    ModbusPollingCycle mCycles[ MODBUS_POLLING_SIGNATURES ];
+};
+
+#endif // MODBUS_POLLING_CYCLES
@@ -1,6 +1,7 @@
 #include "ModbusSimulationDataGenerator.h"
 #include "ModbusAnalyzerSettings.h"
 #include "ModbusAnalyzerModbusExtension.h"
+#include "ModbusCrc.h"
 
 ModbusSimulationDataGenerator::ModbusSimulationDataGenerator()
 {
@@ -16,8 +17,11 @@ void ModbusSimulationDataGenerator::Initialize( U32 simulation_sample_rate, Modb
     mSettings = settings;
 
     mClockGenerator.Init( mSettings->mBitRate, simulation_sample_rate );
-    mModbusSimulationData.SetChannel( mSettings->mInputChannel );
-    mModbusSimulationData.SetSampleRate( simulation_sample_rate );
+
+    mRtuMode = mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient ||
+               mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
+               mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+               mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex;
 
     if( mSettings->mInverted == false )
     {
@@ -30,8 +34,15 @@ void ModbusSimulationDataGenerator::Initialize( U32 simulation_sample_rate, Modb
         mBitHigh = BIT_LOW;
     }
 
-    mModbusSimulationData.SetInitialBitState( mBitHigh );
-    mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+    // everything goes out on the input channel, except the responses in full duplex modes
+    mRequestSimulationData = mModbusSimulationChannels.Add( mSettings->mInputChannel, simulation_sample_rate, mBitHigh );
+    if( mSettings->IsFullDuplex() )
+        mResponseSimulationData = mModbusSimulationChannels.Add( mSettings->mResponseChannel, simulation_sample_rate, mBitHigh );
+    else
+        mResponseSimulationData = mRequestSimulationData;
+
+    mModbusSimulationData = mRequestSimulationData;
+    mModbusSimulationChannels.AdvanceAll( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
     mValue = 0;
     mNumBitsMask = 0;
@@ -42,9 +53,6 @@ void ModbusSimulationDataGenerator::Initialize( U32 simulation_sample_rate, Modb
         mNumBitsMask <<= 1;
         mNumBitsMask |= 0x1;
     }
-
-    // used for calculating Modbus Checksum values
-    init_crc16_tab();
 }
 
 U32 ModbusSimulationDataGenerator::GenerateSimulationData( U64 largest_sample_requested, U32 sample_rate,
@@ -53,7 +61,7 @@ U32 ModbusSimulationDataGenerator::GenerateSimulationData( U64 largest_sample_re
     U64 adjusted_largest_sample_requested =
         AnalyzerHelpers::AdjustSimulationTargetSample( largest_sample_requested, sample_rate, mSimulationSampleRateHz );
 
-    while( mModbusSimulationData.GetCurrentSampleNumber() < adjusted_largest_sample_requested )
+    while( mModbusSimulationData->GetCurrentSampleNumber() < adjusted_largest_sample_requested )
     {
         if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient ||
             mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIClient )
@@ -61,98 +69,98 @@ U32 ModbusSimulationDataGenerator::GenerateSimulationData( U64 largest_sample_re
             // Simulate the Client Device on a Modbus channel
 
             SendGenericRequest( 0x01, 0x01, 0x0013, 0x0013 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenericRequest( 0x01, 0x02, 0x00C4, 0x0016 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenericRequest( 0x01, 0x03, 0x006B, 0x0003 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenericRequest( 0x01, 0x04, 0x0008, 0x0001 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenericRequest( 0x01, 0x05, 0x00AC, 0xFF00 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenericRequest( 0x01, 0x06, 0x0001, 0x0003 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenDiagnosticRequest( 0x01, 0x07 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // all available subcodes used for Diagnostics command
             SendRequest_Diagnostics( 0x01, RETURN_QUERY_DATA, 0xA537 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RESTART_COMMUNICATIONS_OPTION, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RESTART_COMMUNICATIONS_OPTION, 0xFF00 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_DIAGNOSTIC_REGISTER, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, CHANGE_ASCII_INPUT_DELIM, 0x4300 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, FORCE_LISTEN_ONLY_MODE, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, CLEAR_COUNTERS_AND_DIAG_REGISTER, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_MESSAGE_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_COMM_ERROR_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_EXCEPTION_ERROR_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_MESSAGE_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_NO_RESPONSE_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_NAK_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_BUSY_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_CHAR_OVERRUN_COUNT, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, CLEAR_OVERRUN_COUNTER_AND_FLAG, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenDiagnosticRequest( 0x01, 0x0B );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenDiagnosticRequest( 0x01, 0x0C );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U8 temp[] = { 0xCD, 0x01 };
             SendWriteMultipleCoilsRequest( 0x01, 0x0013, 0x000A, 0x02, temp );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U16 temp2[] = { 0x000A, 0x0102 };
             SendWriteMultipleRegistersRequest( 0x01, 0x0001, 0x0002, 0x04, temp2 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendGenDiagnosticRequest( 0x01, 0x11 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U8 RefTypes[] = { 0x06, 0x06 };
             U16 FileNumbers[] = { 0x0004, 0x0003 };
             U16 RecordNumbers[] = { 0x0001, 0x0009 };
             U16 RecordLengths[] = { 0x0002, 0x0002 };
             SendReadFileRecordRequest( 0x01, 0x0E, RefTypes, FileNumbers, RecordNumbers, RecordLengths );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U8 RefTypes2[] = { 0x06 };
             U16 FileNumbers2[] = { 0x0004 };
@@ -160,130 +168,130 @@ U32 ModbusSimulationDataGenerator::GenerateSimulationData( U64 largest_sample_re
             U16 RecordLengths2[] = { 0x0003 };
             U16 RecordData2[ 1 ][ 3 ] = { { 0x06AF, 0x04BE, 0x100D } };
             SendWriteFileRecordRequest( 0x01, 0x0D, RefTypes2, FileNumbers2, RecordNumbers2, RecordLengths2, RecordData2 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendMaskWriteRegisterRequest( 0x01, 0x0004, 0x00F2, 0x0025 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U16 WriteMe[] = { 0x00FF, 0x00FF, 0x00FF };
             SendReadWriteMultipleRegisters( 0x01, 0x0003, 0x0006, 0x000E, 0x0003, 0x06, WriteMe );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendReadFIFOQueueRequest( 0x01, 0x04DE );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
         }
         else if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer ||
                  mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIServer )
         {
             // Simulate a Server Device on a Modbus/RTU channel
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .075 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .075 ) );
 
             U8 bytes[ 3 ] = { 0xCD, 0x6B, 0x05 };
             SendGenericResponse( 0x01, 0x01, 0x03, bytes );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U8 status[ 3 ] = { 0xAC, 0xDB, 0x35 };
             SendGenericResponse( 0x01, 0x02, 0x03, status );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U16 values[ 3 ] = { 0x022B, 0x0000, 0x0064 };
             SendGeneric2Response( 0x01, 0x03, 0x06, values );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U16 values2[ 1 ] = { 0x000A };
             SendGeneric2Response( 0x01, 0x04, 0x02, values2 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // response is an echo of request so lets just reuse the code
             SendGenericRequest( 0x01, 0x05, 0x00AC, 0xFF00 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // response is an echo of request so lets just reuse the code
             SendGenericRequest( 0x01, 0x06, 0x0001, 0x0003 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendReadExceptionStatusResponse( 0x01, 0x07, 0x6D );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // all available subcodes used for Diagnostics command
             // responses are echoes (in most cases but sometimes filled with requested data)
             SendRequest_Diagnostics( 0x01, RETURN_QUERY_DATA, 0xA537 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RESTART_COMMUNICATIONS_OPTION, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RESTART_COMMUNICATIONS_OPTION, 0xFF00 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_DIAGNOSTIC_REGISTER, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, CHANGE_ASCII_INPUT_DELIM, 0x4300 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // no response required
             // SendRequest_Diagnostics(0x01, FORCE_LISTEN_ONLY_MODE, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, CLEAR_COUNTERS_AND_DIAG_REGISTER, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_MESSAGE_COUNT, 0x0005 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_COMM_ERROR_COUNT, 0x0004 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_EXCEPTION_ERROR_COUNT, 0x0003 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_MESSAGE_COUNT, 0x0002 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_NO_RESPONSE_COUNT, 0x0001 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_NAK_COUNT, 0x0002 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_SERVER_BUSY_COUNT, 0x0003 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, RETURN_BUS_CHAR_OVERRUN_COUNT, 0x0004 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             SendRequest_Diagnostics( 0x01, CLEAR_OVERRUN_COUNTER_AND_FLAG, 0x0000 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // response is an echo of request so lets just reuse the code
             SendGenericRequest( 0x01, 0x0B, 0xFFFF, 0x0108 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U8 someevents[] = { 0x20, 0x00 };
             SendGetCommEventLogResponse( 0x01, 0x08, 0x0000, 0x0108, 0x0121, someevents );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // use existing code to simulate this message also
             SendGenericRequest( 0x01, 0x0F, 0x0013, 0x000A );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // use existing code to simulate this message also
             SendGenericRequest( 0x01, 0x10, 0x0001, 0x0002 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // This one is device specific, but here's a sample implementation for decode purposes
             // ServerID is "Saleae" followed by 0xFF (ON)
             U8 ServerID[] = { 0x53, 0x61, 0x6C, 0x65, 0x61, 0x65, 0xFF };
             SendReportServerIDResponse( 0x01, 0x07, ServerID );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // 0x14 here
             U8 RefTypes1[] = { 0x06, 0x06 };
             U8 RecordLengths1[] = { 0x05, 0x05 };
             U16 RecordData1[ 2 ][ 2 ] = { { 0x0DFE, 0x0020 }, { 0x33CD, 0x0040 } };
             SendWriteFileRecordResponse( 0x01, 0x0C, RecordLengths1, RefTypes1, RecordData1 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // 0x15 response is just echo of request
             U8 RefTypes2[] = { 0x06 };
@@ -292,271 +300,375 @@ U32 ModbusSimulationDataGenerator::GenerateSimulationData( U64 largest_sample_re
             U16 RecordLengths2[] = { 0x0003 };
             U16 RecordData2[ 1 ][ 3 ] = { { 0x06AF, 0x04BE, 0x100D } };
             SendWriteFileRecordRequest( 0x01, 0x0D, RefTypes2, FileNumbers2, RecordNumbers2, RecordLengths2, RecordData2 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // this message is an echo of the request
             SendMaskWriteRegisterRequest( 0x01, 0x0004, 0x00F2, 0x0025 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             U16 items[ 6 ] = { 0x00FE, 0x0ACD, 0x0001, 0x0003, 0x000D, 0x00FF };
             SendGeneric2Response( 0x01, 0x17, 0x0C, items );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Read FIFO Queue
             U16 Qdata[] = { 0x01B8, 0x1284 };
             SendReadFIFOQueueResponse( 0x01, 0x0006, 0x0002, Qdata );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // NAKs for 0x01
             ModbusSimulationDataGenerator::SendException( 0x01, 0x01, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x01, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x01, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x01, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x02
             ModbusSimulationDataGenerator::SendException( 0x01, 0x02, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x02, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x02, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x02, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x03
             ModbusSimulationDataGenerator::SendException( 0x01, 0x03, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x03, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x03, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x03, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x04
             ModbusSimulationDataGenerator::SendException( 0x01, 0x04, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x04, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x04, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x04, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x05
             ModbusSimulationDataGenerator::SendException( 0x01, 0x05, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x05, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x05, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x05, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x06
             ModbusSimulationDataGenerator::SendException( 0x01, 0x06, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x06, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x06, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x06, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x07
             ModbusSimulationDataGenerator::SendException( 0x01, 0x07, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x07, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x08
             ModbusSimulationDataGenerator::SendException( 0x01, 0x08, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x08, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x08, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x0B
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0B, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0B, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x0C
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0C, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0C, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x0F
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0F, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0F, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0F, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x0F, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x10
             ModbusSimulationDataGenerator::SendException( 0x01, 0x10, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x10, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x10, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x10, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x11
             ModbusSimulationDataGenerator::SendException( 0x01, 0x11, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x11, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x14
             ModbusSimulationDataGenerator::SendException( 0x01, 0x14, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x14, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x14, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x14, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x14, 0x08 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x15
             ModbusSimulationDataGenerator::SendException( 0x01, 0x15, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x15, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x15, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x15, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x15, 0x08 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x16
             ModbusSimulationDataGenerator::SendException( 0x01, 0x16, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x16, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x16, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x16, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x17
             ModbusSimulationDataGenerator::SendException( 0x01, 0x17, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x17, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x17, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x17, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x18
             ModbusSimulationDataGenerator::SendException( 0x01, 0x18, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x18, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x18, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x18, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for 0x2B
             ModbusSimulationDataGenerator::SendException( 0x01, 0x2B, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x2B, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x2B, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x2B, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             // Naks for unrecognized function
             ModbusSimulationDataGenerator::SendException( 0x01, 0x71, 0x01 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x71, 0x02 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x71, 0x03 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
 
             ModbusSimulationDataGenerator::SendException( 0x01, 0x71, 0x04 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .125 ) );
+        }
+        else if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUFullDuplex ||
+                 mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIFullDuplex )
+        {
+            // Simulate a Client polling a Server, with the responses on a channel of their own
+            SendGenericRequest( 0x01, 0x03, 0x006B, 0x0003 );
+            SwitchToLine( mResponseSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .005 ) );
+
+            U16 values[ 3 ] = { 0x022B, 0x0000, 0x0064 };
+            SendGeneric2Response( 0x01, 0x03, 0x06, values );
+            SwitchToLine( mRequestSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            U16 WriteMe[] = { 0x00FF, 0x00FF, 0x00FF };
+            SendReadWriteMultipleRegisters( 0x01, 0x0003, 0x0006, 0x000E, 0x0003, 0x06, WriteMe );
+            SwitchToLine( mResponseSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .005 ) );
+
+            U16 values2[ 1 ] = { 0x000A };
+            SendGeneric2Response( 0x01, 0x17, 0x02, values2 );
+            SwitchToLine( mRequestSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            SendGenericRequest( 0x01, 0x06, 0x0001, 0x0003 );
+            SwitchToLine( mResponseSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .005 ) );
+
+            // the response to a write single register is an echo of the request
+            SendGenericRequest( 0x01, 0x06, 0x0001, 0x0003 );
+            SwitchToLine( mRequestSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            SendGenericRequest( 0x01, 0x04, 0x0008, 0x0001 );
+            SwitchToLine( mResponseSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .005 ) );
+
+            ModbusSimulationDataGenerator::SendException( 0x01, 0x04, 0x02 );
+            SwitchToLine( mRequestSimulationData );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+        }
+        else if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUHalfDuplex ||
+                 mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusASCIIHalfDuplex )
+        {
+            // Simulate a Client polling a Server, both on the same Modbus channel
+            SendGenericRequest( 0x01, 0x01, 0x0013, 0x0013 );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .025 ) );
+
+            U8 bytes[ 3 ] = { 0xCD, 0x6B, 0x05 };
+            SendGenericResponse( 0x01, 0x01, 0x03, bytes );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            SendGenericRequest( 0x01, 0x03, 0x006B, 0x0003 );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .025 ) );
+
+            U16 values[ 3 ] = { 0x022B, 0x0000, 0x0064 };
+            SendGeneric2Response( 0x01, 0x03, 0x06, values );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            // the response to a write single register is an echo of the request
+            SendGenericRequest( 0x01, 0x06, 0x0001, 0x0003 );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .025 ) );
+
+            SendGenericRequest( 0x01, 0x06, 0x0001, 0x0003 );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            SendGenericRequest( 0x01, 0x04, 0x0008, 0x0001 );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .025 ) );
+
+            ModbusSimulationDataGenerator::SendException( 0x01, 0x04, 0x02 );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+
+            // a server that answers after only t2 of silence: the response is still decoded, but flagged as a framing error
+            if( mRtuMode )
+            {
+                SendGenericRequest( 0x01, 0x03, 0x006B, 0x0003 );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( GetRtuSilenceS( 2.0 ) ) );
+
+                SendGeneric2Response( 0x01, 0x03, 0x06, values );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByTimeS( .1 ) );
+            }
         }
     }
-    *simulation_channels = &mModbusSimulationData;
+    *simulation_channels = mModbusSimulationChannels.GetArray();
+
+    return mModbusSimulationChannels.GetCount();
+}
+
+void ModbusSimulationDataGenerator::SwitchToLine( SimulationChannelDescriptor* line )
+{
+    // both lines run off the same clock; the one taking over catches up with where the other one stopped
+    U64 now = mModbusSimulationData->GetCurrentSampleNumber();
+    if( line->GetCurrentSampleNumber() < now )
+        line->Advance( U32( now - line->GetCurrentSampleNumber() ) );
+
+    mModbusSimulationData = line;
+}
+
+double ModbusSimulationDataGenerator::GetRtuSilenceS( double character_times )
+{
+    // the same character time the analyzer uses; above 19200 baud the spec fixes it at 500us (t1.5 = 750us, t3.5 = 1.75ms)
+    if( mSettings->mBitRate > 19200 )
+        return character_times * 0.0005;
+
+    U32 bits_per_character = 1 + mSettings->mBitsPerTransfer + 1;
+    if( mSettings->mParity != ModbusAnalyzerEnums::NoneOne )
+        bits_per_character++;
 
-    return 1; // we are retuning the size of the SimulationChannelDescriptor array.  In our case, the "array" is length 1.
+    return character_times * double( bits_per_character ) / double( mSettings->mBitRate );
 }
 
 void ModbusSimulationDataGenerator::CreateModbusByte( U64 value )
 {
     // assume we start high
-    mModbusSimulationData.Transition();                                     // low-going edge for start bit
-    mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod() ); // add start bit time
+    mModbusSimulationData->Transition();                                     // low-going edge for start bit
+    mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod() ); // add start bit time
 
     if( mSettings->mInverted == true )
         value = ~value;
@@ -570,75 +682,75 @@ void ModbusSimulationDataGenerator::CreateModbusByte( U64 value )
 
     for( U32 i = 0; i < num_bits; i++ )
     {
-        mModbusSimulationData.TransitionIfNeeded( bit_extractor.GetNextBit() );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod() );
+        mModbusSimulationData->TransitionIfNeeded( bit_extractor.GetNextBit() );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod() );
     }
 
     if( mSettings->mParity == ModbusAnalyzerEnums::EvenOne )
     {
         if( AnalyzerHelpers::IsEven( AnalyzerHelpers::GetOnesCount( value ) ) == true )
-            mModbusSimulationData.TransitionIfNeeded( mBitLow ); // we want to add a zero bit
+            mModbusSimulationData->TransitionIfNeeded( mBitLow ); // we want to add a zero bit
         else
-            mModbusSimulationData.TransitionIfNeeded( mBitHigh ); // we want to add a one bit
+            mModbusSimulationData->TransitionIfNeeded( mBitHigh ); // we want to add a one bit
 
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod() );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod() );
     }
     else if( mSettings->mParity == ModbusAnalyzerEnums::OddOne )
     {
         if( AnalyzerHelpers::IsOdd( AnalyzerHelpers::GetOnesCount( value ) ) == true )
-            mModbusSimulationData.TransitionIfNeeded( mBitLow ); // we want to add a zero bit
+            mModbusSimulationData->TransitionIfNeeded( mBitLow ); // we want to add a zero bit
         else
-            mModbusSimulationData.TransitionIfNeeded( mBitHigh );
+            mModbusSimulationData->TransitionIfNeeded( mBitHigh );
 
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod() );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod() );
     }
 
-    mModbusSimulationData.TransitionIfNeeded( mBitHigh ); // we need to end high
+    mModbusSimulationData->TransitionIfNeeded( mBitHigh ); // we need to end high
 
     // lets pad the end a bit for the stop bit:
     // we're still using these old settings becuase it's not worth it right now to tear them all out.
-    mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 1.0 ) );
+    mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 1.0 ) );
 
     if( mSettings->mParity == ModbusAnalyzerEnums::NoneTwo )
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 1.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 1.0 ) );
 }
 
 
 void ModbusSimulationDataGenerator::SendGenericRequest( U8 DeviceID, U8 FuncCode, U16 StartingAddress, U16 Quantity )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( FuncCode );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( StartingAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( StartingAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( Quantity & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( StartingAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( Quantity & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( Quantity & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, FuncCode );
-        CRCValue = update_CRC( CRCValue, StartingAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( StartingAddress & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, Quantity & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( Quantity & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, FuncCode );
+        CRCValue = crc16_modbus_update( CRCValue, ( StartingAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, StartingAddress & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( Quantity & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, Quantity & 0x00FF );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -656,70 +768,70 @@ void ModbusSimulationDataGenerator::SendGenericRequest( U8 DeviceID, U8 FuncCode
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( StartingAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Quantity & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Quantity & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Quantity & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( Quantity & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 
 void ModbusSimulationDataGenerator::SendGenDiagnosticRequest( U8 DeviceID, U8 FuncCode )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( FuncCode );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, FuncCode );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, FuncCode );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -733,75 +845,75 @@ void ModbusSimulationDataGenerator::SendGenDiagnosticRequest( U8 DeviceID, U8 Fu
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendMaskWriteRegisterRequest( U8 DeviceID, U16 ReferenceAddress, U16 And_Mask, U16 Or_Mask )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x16 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( ReferenceAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ReferenceAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( And_Mask & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( ReferenceAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( And_Mask & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( Or_Mask & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( And_Mask & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( Or_Mask & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( Or_Mask & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x16 );
-        CRCValue = update_CRC( CRCValue, ReferenceAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( ReferenceAddress & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, And_Mask & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( And_Mask & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, Or_Mask & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( Or_Mask & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x16 );
+        CRCValue = crc16_modbus_update( CRCValue, ( ReferenceAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, ReferenceAddress & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( And_Mask & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, And_Mask & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( Or_Mask & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, Or_Mask & 0x00FF );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -821,86 +933,86 @@ void ModbusSimulationDataGenerator::SendMaskWriteRegisterRequest( U8 DeviceID, U
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '6' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ReferenceAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( ReferenceAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( ReferenceAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ReferenceAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( And_Mask & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( And_Mask & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( And_Mask & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( And_Mask & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Or_Mask & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Or_Mask & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Or_Mask & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( Or_Mask & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendReadFIFOQueueRequest( U8 DeviceID, U16 FIFOAddress )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x18 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( FIFOAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( FIFOAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( FIFOAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x18 );
-        CRCValue = update_CRC( CRCValue, FIFOAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( FIFOAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x18 );
+        CRCValue = crc16_modbus_update( CRCValue, ( FIFOAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, FIFOAddress & 0x00FF );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -916,77 +1028,77 @@ void ModbusSimulationDataGenerator::SendReadFIFOQueueRequest( U8 DeviceID, U16 F
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '8' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( FIFOAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( FIFOAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( FIFOAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( FIFOAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 
 void ModbusSimulationDataGenerator::SendRequest_Diagnostics( U8 DeviceID, U16 SubFunction, U16 Data )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x08 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( SubFunction & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( SubFunction & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( Data & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( SubFunction & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( Data & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( Data & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x08 );
-        CRCValue = update_CRC( CRCValue, SubFunction & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( SubFunction & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, Data & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( Data & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x08 );
+        CRCValue = crc16_modbus_update( CRCValue, ( SubFunction & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, SubFunction & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( Data & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, Data & 0x00FF );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1004,101 +1116,101 @@ void ModbusSimulationDataGenerator::SendRequest_Diagnostics( U8 DeviceID, U16 Su
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '0' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '8' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( SubFunction & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( SubFunction & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( SubFunction & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( SubFunction & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Data & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Data & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Data & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( Data & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendWriteMultipleCoilsRequest( U8 DeviceID, U16 StartingAddress, U16 Quantity, U8 ByteCount,
                                                                    U8 Values[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x0F );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( StartingAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( StartingAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( Quantity & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( StartingAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( Quantity & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( Quantity & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ByteCount; i++ )
         {
             CreateModbusByte( Values[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x0F );
-        CRCValue = update_CRC( CRCValue, StartingAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( StartingAddress & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, Quantity & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( Quantity & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x0F );
+        CRCValue = crc16_modbus_update( CRCValue, ( StartingAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, StartingAddress & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( Quantity & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, Quantity & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         for( int i = 0; i < ByteCount; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Values[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, Values[ i ] );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1122,60 +1234,60 @@ void ModbusSimulationDataGenerator::SendWriteMultipleCoilsRequest( U8 DeviceID,
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '0' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( 'F' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( StartingAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Quantity & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Quantity & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Quantity & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( Quantity & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < ByteCount; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Values[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
@@ -1183,58 +1295,58 @@ void ModbusSimulationDataGenerator::SendWriteMultipleCoilsRequest( U8 DeviceID,
 void ModbusSimulationDataGenerator::SendWriteMultipleRegistersRequest( U8 DeviceID, U16 StartingAddress, U16 Quantity, U8 ByteCount,
                                                                        U16 Values[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x10 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( StartingAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( StartingAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( Quantity & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( StartingAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( Quantity & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( Quantity & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ByteCount / 2; i++ )
         {
-            CreateModbusByte( Values[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
             CreateModbusByte( ( Values[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+            CreateModbusByte( Values[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x10 );
-        CRCValue = update_CRC( CRCValue, StartingAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( StartingAddress & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, Quantity & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( Quantity & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x10 );
+        CRCValue = crc16_modbus_update( CRCValue, ( StartingAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, StartingAddress & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( Quantity & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, Quantity & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         for( int i = 0; i < ByteCount / 2; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Values[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, Values[ i ] & 0x00FF );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1259,64 +1371,64 @@ void ModbusSimulationDataGenerator::SendWriteMultipleRegistersRequest( U8 Device
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '0' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( StartingAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( StartingAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Quantity & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Quantity & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( Quantity & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( Quantity & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < ByteCount / 2; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Values[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
@@ -1324,62 +1436,62 @@ void ModbusSimulationDataGenerator::SendReadFileRecordRequest( U8 DeviceID, U8 B
                                                                U16 SubReqFileNumbers[], U16 SubReqRecordNumbers[],
                                                                U16 SubReqRecordLengths[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x14 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ByteCount / 7; i++ )
         {
             CreateModbusByte( SubReqReferenceTypes[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-            CreateModbusByte( SubReqFileNumbers[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( ( SubReqFileNumbers[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-            CreateModbusByte( SubReqRecordNumbers[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            CreateModbusByte( SubReqFileNumbers[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( ( SubReqRecordNumbers[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-            CreateModbusByte( SubReqRecordLengths[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            CreateModbusByte( SubReqRecordNumbers[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( ( SubReqRecordLengths[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+            CreateModbusByte( SubReqRecordLengths[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x14 );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x14 );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         for( int i = 0; i < ByteCount / 7; i++ )
         {
-            CRCValue = update_CRC( CRCValue, SubReqReferenceTypes[ i ] );
-            CRCValue = update_CRC( CRCValue, SubReqFileNumbers[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( SubReqFileNumbers[ i ] & 0xFF00 ) >> 8 );
-            CRCValue = update_CRC( CRCValue, SubReqRecordNumbers[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( SubReqRecordNumbers[ i ] & 0xFF00 ) >> 8 );
-            CRCValue = update_CRC( CRCValue, SubReqRecordLengths[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( SubReqRecordLengths[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqReferenceTypes[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, ( SubReqFileNumbers[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqFileNumbers[ i ] & 0x00FF );
+            CRCValue = crc16_modbus_update( CRCValue, ( SubReqRecordNumbers[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqRecordNumbers[ i ] & 0x00FF );
+            CRCValue = crc16_modbus_update( CRCValue, ( SubReqRecordLengths[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqRecordLengths[ i ] & 0x00FF );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1405,69 +1517,69 @@ void ModbusSimulationDataGenerator::SendReadFileRecordRequest( U8 DeviceID, U8 B
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '4' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < ByteCount / 7; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( SubReqReferenceTypes[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqReferenceTypes[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqFileNumbers[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqFileNumbers[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqFileNumbers[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqFileNumbers[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqRecordNumbers[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordNumbers[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordNumbers[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqRecordNumbers[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqRecordLengths[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
@@ -1476,49 +1588,49 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordRequest( U8 DeviceID, U8
                                                                 U16 SubReqFileNumbers[], U16 SubReqRecordNumbers[],
                                                                 U16 SubReqRecordLengths[], U16 SubReqRecordData[ 1 ][ 3 ] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x15 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 totalbytes = 0;
         int i = 0;
         while( totalbytes < ByteCount )
         {
             CreateModbusByte( SubReqReferenceTypes[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-            CreateModbusByte( SubReqFileNumbers[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( ( SubReqFileNumbers[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-            CreateModbusByte( SubReqRecordNumbers[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            CreateModbusByte( SubReqFileNumbers[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( ( SubReqRecordNumbers[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-            CreateModbusByte( SubReqRecordLengths[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            CreateModbusByte( SubReqRecordNumbers[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( ( SubReqRecordLengths[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+            CreateModbusByte( SubReqRecordLengths[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             for( int j = 0; j < SubReqRecordLengths[ i ]; j++ )
             {
-                CreateModbusByte( SubReqRecordData[ i ][ j ] & 0x00FF );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
                 CreateModbusByte( ( SubReqRecordData[ i ][ j ] & 0xFF00 ) >> 8 );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+                CreateModbusByte( SubReqRecordData[ i ][ j ] & 0x00FF );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
             }
 
             totalbytes = totalbytes + ( SubReqRecordLengths[ i ] * 2 ) + 7;
@@ -1526,26 +1638,26 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordRequest( U8 DeviceID, U8
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x15 );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x15 );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         totalbytes = 0;
         i = 0;
         while( totalbytes < ByteCount )
         {
-            CRCValue = update_CRC( CRCValue, SubReqReferenceTypes[ i ] );
-            CRCValue = update_CRC( CRCValue, SubReqFileNumbers[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( SubReqFileNumbers[ i ] & 0xFF00 ) >> 8 );
-            CRCValue = update_CRC( CRCValue, SubReqRecordNumbers[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( SubReqRecordNumbers[ i ] & 0xFF00 ) >> 8 );
-            CRCValue = update_CRC( CRCValue, SubReqRecordLengths[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( SubReqRecordLengths[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqReferenceTypes[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, ( SubReqFileNumbers[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqFileNumbers[ i ] & 0x00FF );
+            CRCValue = crc16_modbus_update( CRCValue, ( SubReqRecordNumbers[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqRecordNumbers[ i ] & 0x00FF );
+            CRCValue = crc16_modbus_update( CRCValue, ( SubReqRecordLengths[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqRecordLengths[ i ] & 0x00FF );
 
             for( int j = 0; j < SubReqRecordLengths[ i ]; j++ )
             {
-                CRCValue = update_CRC( CRCValue, SubReqRecordData[ i ][ j ] & 0x00FF );
-                CRCValue = update_CRC( CRCValue, ( SubReqRecordData[ i ][ j ] & 0xFF00 ) >> 8 );
+                CRCValue = crc16_modbus_update( CRCValue, ( SubReqRecordData[ i ][ j ] & 0xFF00 ) >> 8 );
+                CRCValue = crc16_modbus_update( CRCValue, SubReqRecordData[ i ][ j ] & 0x00FF );
             }
 
             totalbytes = totalbytes + ( SubReqRecordLengths[ i ] * 2 ) + 7;
@@ -1553,10 +1665,10 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordRequest( U8 DeviceID, U8
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1593,71 +1705,71 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordRequest( U8 DeviceID, U8
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '5' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         totalbytes = 0;
         i = 0;
         while( totalbytes < ByteCount )
         {
             CreateModbusByte( BinToLATIN1( ( SubReqReferenceTypes[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqReferenceTypes[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqFileNumbers[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqFileNumbers[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqFileNumbers[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqFileNumbers[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqRecordNumbers[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordNumbers[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordNumbers[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqRecordNumbers[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqRecordLengths[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             for( int j = 0; j < SubReqRecordLengths[ i ]; j++ )
             {
                 CreateModbusByte( BinToLATIN1( ( SubReqRecordData[ i ][ j ] & 0xF000 ) >> 12 ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
                 CreateModbusByte( BinToLATIN1( ( SubReqRecordData[ i ][ j ] & 0x0F00 ) >> 8 ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
                 CreateModbusByte( BinToLATIN1( ( SubReqRecordData[ i ][ j ] & 0xF0 ) >> 4 ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
                 CreateModbusByte( BinToLATIN1( SubReqRecordData[ i ][ j ] & 0xF ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             }
 
             totalbytes = totalbytes + ( SubReqRecordLengths[ i ] * 2 ) + 7;
@@ -1665,14 +1777,14 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordRequest( U8 DeviceID, U8
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
@@ -1680,74 +1792,74 @@ void ModbusSimulationDataGenerator::SendReadWriteMultipleRegisters( U8 DeviceID,
                                                                     U16 WriteStartingAddress, U16 QuantityToWrite, U8 WriteByteCount,
                                                                     U16 Values[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x17 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( ReadStartingAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ReadStartingAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( QuantityToRead & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( ReadStartingAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( QuantityToRead & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( WriteStartingAddress & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( QuantityToRead & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( WriteStartingAddress & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( QuantityToWrite & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( WriteStartingAddress & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( QuantityToWrite & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( QuantityToWrite & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( WriteByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < WriteByteCount / 2; i++ )
         {
-            CreateModbusByte( Values[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
             CreateModbusByte( ( Values[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+            CreateModbusByte( Values[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x17 );
-        CRCValue = update_CRC( CRCValue, ReadStartingAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( ReadStartingAddress & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, QuantityToRead & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( QuantityToRead & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, WriteStartingAddress & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( WriteStartingAddress & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, QuantityToWrite & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( QuantityToWrite & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, WriteByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x17 );
+        CRCValue = crc16_modbus_update( CRCValue, ( ReadStartingAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, ReadStartingAddress & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( QuantityToRead & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, QuantityToRead & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( WriteStartingAddress & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, WriteStartingAddress & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( QuantityToWrite & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, QuantityToWrite & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, WriteByteCount );
 
         for( int i = 0; i < WriteByteCount / 2; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Values[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, Values[ i ] & 0x00FF );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1776,120 +1888,120 @@ void ModbusSimulationDataGenerator::SendReadWriteMultipleRegisters( U8 DeviceID,
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '7' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ReadStartingAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( ReadStartingAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( ReadStartingAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ReadStartingAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( QuantityToRead & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( QuantityToRead & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( QuantityToRead & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( QuantityToRead & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( WriteStartingAddress & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( WriteStartingAddress & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( WriteStartingAddress & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( WriteStartingAddress & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( QuantityToWrite & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( QuantityToWrite & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( QuantityToWrite & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( QuantityToWrite & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( WriteByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( WriteByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < WriteByteCount / 2; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Values[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 // Responses
 
 void ModbusSimulationDataGenerator::SendGenericResponse( U8 DeviceID, U8 FuncCode, U8 ByteCount, U8 Status[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( FuncCode );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ByteCount; i++ )
         {
             CreateModbusByte( Status[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, FuncCode );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, FuncCode );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         for( int i = 0; i < ByteCount; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Status[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, Status[ i ] );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -1909,86 +2021,86 @@ void ModbusSimulationDataGenerator::SendGenericResponse( U8 DeviceID, U8 FuncCod
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ByteCount >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < ByteCount; i++ )
         {
             CreateModbusByte( BinToLATIN1( Status[ i ] >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( Status[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 
 void ModbusSimulationDataGenerator::SendGeneric2Response( U8 DeviceID, U8 FuncCode, U8 ByteCount, U16 Values[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( FuncCode );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ByteCount / 2; i++ )
         {
-            CreateModbusByte( Values[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
             CreateModbusByte( ( Values[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+            CreateModbusByte( Values[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, FuncCode );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, FuncCode );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         for( int i = 0; i < ByteCount / 2; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Values[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, Values[ i ] & 0x00FF );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2009,72 +2121,72 @@ void ModbusSimulationDataGenerator::SendGeneric2Response( U8 DeviceID, U8 FuncCo
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < ByteCount / 2; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Values[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendReadExceptionStatusResponse( U8 DeviceID, U8 FuncCode, U8 Data )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( FuncCode );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( Data );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, FuncCode );
-        CRCValue = update_CRC( CRCValue, Data );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, FuncCode );
+        CRCValue = crc16_modbus_update( CRCValue, Data );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2089,88 +2201,88 @@ void ModbusSimulationDataGenerator::SendReadExceptionStatusResponse( U8 DeviceID
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( Data >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( Data & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendReadFIFOQueueResponse( U8 DeviceID, U16 ByteCount, U16 FIFOCount, U16 Values[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x18 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( ByteCount & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ByteCount & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( FIFOCount & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( ByteCount & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( FIFOCount & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( FIFOCount & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < FIFOCount; i++ )
         {
-            CreateModbusByte( Values[ i ] & 0x00FF );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
             CreateModbusByte( ( Values[ i ] & 0xFF00 ) >> 8 );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+            CreateModbusByte( Values[ i ] & 0x00FF );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x18 );
-        CRCValue = update_CRC( CRCValue, ByteCount & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( ByteCount & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, FIFOCount & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( FIFOCount & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x18 );
+        CRCValue = crc16_modbus_update( CRCValue, ( ByteCount & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( FIFOCount & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, FIFOCount & 0x00FF );
 
         for( int i = 0; i < FIFOCount; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Values[ i ] & 0x00FF );
-            CRCValue = update_CRC( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, ( Values[ i ] & 0xFF00 ) >> 8 );
+            CRCValue = crc16_modbus_update( CRCValue, Values[ i ] & 0x00FF );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2194,128 +2306,128 @@ void ModbusSimulationDataGenerator::SendReadFIFOQueueResponse( U8 DeviceID, U16
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( 0x1 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( 0x8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( FIFOCount & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( FIFOCount & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( FIFOCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FIFOCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
 
         for( int i = 0; i < FIFOCount; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF000 ) >> 12 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0x0F00 ) >> 8 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( ( Values[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Values[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendGetCommEventLogResponse( U8 DeviceID, U8 ByteCount, U16 Status, U16 EventCount, U16 MessageCount,
                                                                  U8 Events[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x0C );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
-        CreateModbusByte( Status & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( Status & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( EventCount & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( Status & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( EventCount & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
-        CreateModbusByte( MessageCount & 0x00FF );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        CreateModbusByte( EventCount & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( MessageCount & 0xFF00 ) >> 8 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+        CreateModbusByte( MessageCount & 0x00FF );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ( ByteCount - 6 ); i++ )
         {
             CreateModbusByte( Events[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x0C );
-        CRCValue = update_CRC( CRCValue, ByteCount );
-        CRCValue = update_CRC( CRCValue, Status & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( Status & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, EventCount & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( EventCount & 0xFF00 ) >> 8 );
-        CRCValue = update_CRC( CRCValue, MessageCount & 0x00FF );
-        CRCValue = update_CRC( CRCValue, ( MessageCount & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x0C );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, ( Status & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, Status & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( EventCount & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, EventCount & 0x00FF );
+        CRCValue = crc16_modbus_update( CRCValue, ( MessageCount & 0xFF00 ) >> 8 );
+        CRCValue = crc16_modbus_update( CRCValue, MessageCount & 0x00FF );
 
         for( int i = 0; i < ( ByteCount - 6 ); i++ )
         {
-            CRCValue = update_CRC( CRCValue, Events[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, Events[ i ] );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2343,117 +2455,117 @@ void ModbusSimulationDataGenerator::SendGetCommEventLogResponse( U8 DeviceID, U8
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( 0x0 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( 0xC ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Status & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Status & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( Status & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( Status & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( EventCount & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( EventCount & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( EventCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( EventCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( MessageCount & 0xF000 ) >> 12 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( MessageCount & 0x0F00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( MessageCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( MessageCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
 
         for( int i = 0; i < ( ByteCount - 6 ); i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Events[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Events[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendReportServerIDResponse( U8 DeviceID, U8 ByteCount, U8 Data[] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x11 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         for( int i = 0; i < ByteCount; i++ )
         {
             CreateModbusByte( Data[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x11 );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x11 );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         for( int i = 0; i < ByteCount; i++ )
         {
-            CRCValue = update_CRC( CRCValue, Data[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, Data[ i ] );
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2474,77 +2586,77 @@ void ModbusSimulationDataGenerator::SendReportServerIDResponse( U8 DeviceID, U8
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( 0x1 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( 0x1 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         for( int i = 0; i < ByteCount; i++ )
         {
             CreateModbusByte( BinToLATIN1( ( Data[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( Data[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendWriteFileRecordResponse( U8 DeviceID, U8 ByteCount, U8 SubReqRecordLengths[],
                                                                  U8 SubReqReferenceTypes[], U16 SubReqRecordData[ 2 ][ 2 ] )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( 0x14 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ByteCount );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 totalbytes = 0;
         int i = 0;
         while( totalbytes < ByteCount )
         {
             CreateModbusByte( SubReqRecordLengths[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             CreateModbusByte( SubReqReferenceTypes[ i ] );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
             for( int j = 0; j < ( SubReqRecordLengths[ i ] - 1 ) / 2; j++ )
             {
-                CreateModbusByte( SubReqRecordData[ i ][ j ] & 0x00FF );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
-
                 CreateModbusByte( ( SubReqRecordData[ i ][ j ] & 0xFF00 ) >> 8 );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+
+                CreateModbusByte( SubReqRecordData[ i ][ j ] & 0x00FF );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
             }
 
             totalbytes = totalbytes + SubReqRecordLengths[ i ] + 2;
@@ -2552,22 +2664,22 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordResponse( U8 DeviceID, U8
         }
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, 0x14 );
-        CRCValue = update_CRC( CRCValue, ByteCount );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, 0x14 );
+        CRCValue = crc16_modbus_update( CRCValue, ByteCount );
 
         totalbytes = 0;
         i = 0;
         while( totalbytes < ByteCount )
         {
-            CRCValue = update_CRC( CRCValue, SubReqRecordLengths[ i ] );
-            CRCValue = update_CRC( CRCValue, SubReqReferenceTypes[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqRecordLengths[ i ] );
+            CRCValue = crc16_modbus_update( CRCValue, SubReqReferenceTypes[ i ] );
 
 
             for( int j = 0; j < ( SubReqRecordLengths[ i ] - 1 ) / 2; j++ )
             {
-                CRCValue = update_CRC( CRCValue, SubReqRecordData[ i ][ j ] & 0x00FF );
-                CRCValue = update_CRC( CRCValue, ( SubReqRecordData[ i ][ j ] & 0xFF00 ) >> 8 );
+                CRCValue = crc16_modbus_update( CRCValue, ( SubReqRecordData[ i ][ j ] & 0xFF00 ) >> 8 );
+                CRCValue = crc16_modbus_update( CRCValue, SubReqRecordData[ i ][ j ] & 0x00FF );
             }
 
             totalbytes = totalbytes + SubReqRecordLengths[ i ] + 2;
@@ -2575,10 +2687,10 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordResponse( U8 DeviceID, U8
         }
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2610,49 +2722,49 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordResponse( U8 DeviceID, U8
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '1' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '4' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ByteCount & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ByteCount & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         totalbytes = 0;
         i = 0;
         while( totalbytes < ByteCount )
         {
             CreateModbusByte( BinToLATIN1( ( SubReqRecordLengths[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqRecordLengths[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             CreateModbusByte( BinToLATIN1( ( SubReqReferenceTypes[ i ] & 0xF0 ) >> 4 ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             CreateModbusByte( BinToLATIN1( SubReqReferenceTypes[ i ] & 0xF ) );
-            mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+            mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
             for( int j = 0; j < ( SubReqRecordLengths[ i ] - 1 ) / 2; j++ )
             {
                 CreateModbusByte( BinToLATIN1( ( SubReqRecordData[ i ][ j ] & 0xF000 ) >> 12 ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
                 CreateModbusByte( BinToLATIN1( ( SubReqRecordData[ i ][ j ] & 0x0F00 ) >> 8 ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
                 CreateModbusByte( BinToLATIN1( ( SubReqRecordData[ i ][ j ] & 0xF0 ) >> 4 ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
                 CreateModbusByte( BinToLATIN1( SubReqRecordData[ i ][ j ] & 0xF ) );
-                mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+                mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
             }
 
             totalbytes = totalbytes + SubReqRecordLengths[ i ] + 2;
@@ -2660,40 +2772,40 @@ void ModbusSimulationDataGenerator::SendWriteFileRecordResponse( U8 DeviceID, U8
         }
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
 void ModbusSimulationDataGenerator::SendException( U8 DeviceID, U8 FuncCode, U8 ExceptionCode )
 {
-    if( mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUClient || mSettings->mModbusMode == ModbusAnalyzerEnums::ModbusRTUServer )
+    if( mRtuMode )
     {
         CreateModbusByte( DeviceID );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( FuncCode + 0x80 );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ExceptionCode );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         U16 CRCValue = 0xFFFF; // Modbus/RTU uses CRC-16, calls for initialization to 0xFFFF
-        CRCValue = update_CRC( CRCValue, DeviceID );
-        CRCValue = update_CRC( CRCValue, ( FuncCode + 0x80 ) );
-        CRCValue = update_CRC( CRCValue, ExceptionCode );
+        CRCValue = crc16_modbus_update( CRCValue, DeviceID );
+        CRCValue = crc16_modbus_update( CRCValue, ( FuncCode + 0x80 ) );
+        CRCValue = crc16_modbus_update( CRCValue, ExceptionCode );
 
         CreateModbusByte( ( CRCValue & 0x00FF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
 
         CreateModbusByte( ( ( CRCValue & 0xFF00 ) >> 8 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) ); // insert 10 bit-periods of idle
     }
     else
     {
@@ -2708,72 +2820,34 @@ void ModbusSimulationDataGenerator::SendException( U8 DeviceID, U8 FuncCode, U8
         LRCvalue = LRCvalue & 0x00FF;
 
         CreateModbusByte( ':' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( DeviceID & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( FuncCode + 0x80 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( FuncCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( ExceptionCode & 0x00F0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ExceptionCode & 0xF ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF0 ) >> 4 ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( BinToLATIN1( ( LRCvalue & 0xF ) ) );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
 
         CreateModbusByte( '\r' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
         CreateModbusByte( '\n' );
-        mModbusSimulationData.Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
-    }
-}
-
-U16 ModbusSimulationDataGenerator::update_CRC( U16 crc, U8 c )
-{
-    U16 tmp, short_c;
-
-    short_c = 0x00ff & ( U16 )c;
-
-    // if ( ! crc_tab16_init ) init_crc16_tab();
-
-    tmp = crc ^ short_c;
-    crc = ( crc >> 8 ) ^ crc_tab16[ tmp & 0xff ];
-
-    return crc;
-}
-
-void ModbusSimulationDataGenerator::init_crc16_tab( void )
-{
-    int i, j;
-    U16 crc, c;
-
-    for( i = 0; i < 256; i++ )
-    {
-        crc = 0;
-        c = ( U16 )i;
-
-        for( j = 0; j < 8; j++ )
-        {
-            if( ( crc ^ c ) & 0x0001 )
-                crc = ( crc >> 1 ) ^ 0xA001;
-            else
-                crc = crc >> 1;
-
-            c = c >> 1;
-        }
-
-        crc_tab16[ i ] = crc;
+        mModbusSimulationData->Advance( mClockGenerator.AdvanceByHalfPeriod( 10.0 ) );
     }
 }
 
@@ -31,16 +31,17 @@ class ModbusSimulationDataGenerator
   protected: // Modbus specific
     void CreateModbusByte( U64 value );
     ClockGenerator mClockGenerator;
-    SimulationChannelDescriptor mModbusSimulationData; // if we had more than one channel to simulate, they would need to be in an array
+    bool mRtuMode;
+    SimulationChannelDescriptorGroup mModbusSimulationChannels;
+    SimulationChannelDescriptor* mRequestSimulationData;
+    SimulationChannelDescriptor* mResponseSimulationData; // same as mRequestSimulationData unless in a full duplex mode
+    SimulationChannelDescriptor* mModbusSimulationData;   // the line currently being written to
+    void SwitchToLine( SimulationChannelDescriptor* line );
+    double GetRtuSilenceS( double character_times );
 
 
     /////////// BEGIN MODBUS SECTION //////////////////
 
-    // used for doing CRC calculations
-    U16 crc_tab16[ 256 ];
-    void init_crc16_tab( void );
-    U16 update_CRC( U16 crc, U8 c );
-
     // my own itoa function
     char BinToLATIN1( U8 value );
 
@@ -0,0 +1,53 @@
+#include "ModbusStringCache.h"
+
+ModbusStringCache::ModbusStringCache()
+{
+    mIndex.reserve( MODBUS_STRING_CACHE_ENTRIES );
+}
+
+ModbusStringCache::Strings ModbusStringCache::Find( U64 frame_index, U32 display_base, Kind kind )
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+
+    std::unordered_map<U64, std::list<Entry>::iterator>::iterator found = mIndex.find( Key( frame_index, display_base, kind ) );
+    if( found == mIndex.end() )
+        return Strings();
+
+    mEntries.splice( mEntries.begin(), mEntries, found->second );
+    return found->second->mStrings;
+}
+
+void ModbusStringCache::Add( U64 frame_index, U32 display_base, Kind kind, std::vector<std::string>& strings )
+{
+    // built outside the lock; the strings themselves are moved, not copied
+    std::shared_ptr<std::vector<std::string> > shared = std::make_shared<std::vector<std::string> >();
+    shared->swap( strings );
+
+    std::lock_guard<std::mutex> lock( mMutex );
+
+    U64 key = Key( frame_index, display_base, kind );
+    if( mIndex.find( key ) != mIndex.end() )
+        return;
+
+    // reuse the oldest entry rather than free it and allocate another
+    if( mEntries.size() == MODBUS_STRING_CACHE_ENTRIES )
+    {
+        mIndex.erase( mEntries.back().mKey );
+        mEntries.splice( mEntries.begin(), mEntries, --mEntries.end() );
+    }
+    else
+    {
+        mEntries.push_front( Entry() );
+    }
+
+    Entry& entry = mEntries.front();
+    entry.mKey = key;
+    entry.mStrings = shared;
+    mIndex[ key ] = mEntries.begin();
+}
+
+U64 ModbusStringCache::Key( U64 frame_index, U32 display_base, Kind kind )
+{
+    // display bases and kinds are small enums; frame indexes never get near the top byte
+    return ( frame_index << 8 ) | ( ( display_base & 0x3F ) << 2 ) | kind;
+}
@@ -0,0 +1,52 @@
+#ifndef MODBUS_STRING_CACHE
+#define MODBUS_STRING_CACHE
+
+#include <LogicPublicTypes.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// how many frames' worth of strings are kept; a screenful of bubbles plus the visible part of the data table fits many times over
+#define MODBUS_STRING_CACHE_ENTRIES 4096
+
+// The strings last generated for a frame, so scrolling back and forth doesn't format the same frames over and over. Entries are
+// keyed by frame index, display base and what they were generated for; frames never change once added, so nothing is ever
+// invalidated, only pushed out by the least recently used rule. The strings of an entry are shared rather than copied out, so one
+// pushed out while still in use stays around until it's let go of.
+class ModbusStringCache
+{
+  public:
+    typedef std::shared_ptr<const std::vector<std::string> > Strings;
+
+    enum Kind
+    {
+        InputBubble,
+        ResponseBubble, // full duplex modes ask for the bubbles of each line separately
+        FrameTabular
+    };
+
+    ModbusStringCache();
+
+    // any thread; NULL on a miss
+    Strings Find( U64 frame_index, U32 display_base, Kind kind );
+    // takes the strings over, leaving strings empty
+    void Add( U64 frame_index, U32 display_base, Kind kind, std::vector<std::string>& strings );
+
+  protected:
+    struct Entry
+    {
+        U64 mKey;
+        Strings mStrings;
+    };
+
+    static U64 Key( U64 frame_index, U32 display_base, Kind kind );
+
+    std::mutex mMutex;
+    std::list<Entry> mEntries; // most recently used first
+    std::unordered_map<U64, std::list<Entry>::iterator> mIndex;
+};
+
+#endif // MODBUS_STRING_CACHE
@@ -0,0 +1,139 @@
+#include "ModbusTrafficStats.h"
+
+#include <string.h>
+
+ModbusTrafficStats::ModbusTrafficStats()
+{
+    Reset( 1, 1 );
+}
+
+void ModbusTrafficStats::Reset( U32 sample_rate_hz, U32 line_count )
+{
+    memset( mDevices, 0, sizeof( mDevices ) );
+    memset( mFunctions, 0, sizeof( mFunctions ) );
+    memset( &mTotals, 0, sizeof( mTotals ) );
+    memset( mBusySamples, 0, sizeof( mBusySamples ) );
+
+    for( U32 i = 0; i < 256; i++ )
+        mResponseTimes[ i ].Reset();
+
+    // start out at 10ms per bucket; long captures coarsen from there
+    mBucketWidth = sample_rate_hz / 100;
+    if( mBucketWidth == 0 )
+        mBucketWidth = 1;
+
+    mLastBusySample = 0;
+    mLineCount = line_count > 0 ? line_count : 1;
+}
+
+void ModbusTrafficStats::AddAdu( U8 devaddr, U8 funccode, bool response, U32 length, U8 exception_code, bool checksum_error,
+                                 U32 parity_errors, U32 framing_errors, U64 starting_sample, U64 ending_sample )
+{
+    S32 exception_slot = -1;
+    if( funccode & 0x80 )
+        exception_slot = exception_code < MODBUS_STATS_EXCEPTION_CODES ? exception_code : 0;
+
+    Count( mDevices[ devaddr ], response, length, exception_slot, checksum_error, parity_errors, framing_errors );
+    Count( mFunctions[ funccode & 0x7F ], response, length, exception_slot, checksum_error, parity_errors, framing_errors );
+    Count( mTotals, response, length, exception_slot, checksum_error, parity_errors, framing_errors );
+
+    AddBusyTime( starting_sample, ending_sample );
+}
+
+void ModbusTrafficStats::AddResponseTime( U8 devaddr, U64 microseconds )
+{
+    mResponseTimes[ devaddr ].Add( microseconds );
+}
+
+const ModbusTrafficCounters& ModbusTrafficStats::GetDeviceCounters( U8 devaddr ) const
+{
+    return mDevices[ devaddr ];
+}
+
+const ModbusTrafficCounters& ModbusTrafficStats::GetFunctionCounters( U8 funccode ) const
+{
+    return mFunctions[ funccode & 0x7F ];
+}
+
+const ModbusTrafficCounters& ModbusTrafficStats::GetTotals() const
+{
+    return mTotals;
+}
+
+const ModbusLatencyHistogram& ModbusTrafficStats::GetResponseTimes( U8 devaddr ) const
+{
+    return mResponseTimes[ devaddr ];
+}
+
+U32 ModbusTrafficStats::GetUtilizationBucketCount() const
+{
+    if( mTotals.mAdus == 0 )
+        return 0;
+
+    return U32( mLastBusySample / mBucketWidth ) + 1;
+}
+
+U64 ModbusTrafficStats::GetUtilizationBucketWidth() const
+{
+    return mBucketWidth;
+}
+
+double ModbusTrafficStats::GetUtilization( U32 bucket ) const
+{
+    if( bucket >= MODBUS_STATS_UTILIZATION_BUCKETS )
+        return 0.0;
+
+    return double( mBusySamples[ bucket ] ) / ( double( mBucketWidth ) * mLineCount );
+}
+
+void ModbusTrafficStats::Count( ModbusTrafficCounters& counters, bool response, U32 length, S32 exception_slot, bool checksum_error,
+                                U32 parity_errors, U32 framing_errors )
+{
+    counters.mAdus++;
+    counters.mBytes += length;
+
+    if( response )
+        counters.mResponses++;
+    else
+        counters.mRequests++;
+
+    if( exception_slot >= 0 )
+        counters.mExceptions[ exception_slot ]++;
+
+    if( checksum_error )
+        counters.mChecksumErrors++;
+
+    counters.mParityErrors += parity_errors;
+    counters.mFramingErrors += framing_errors;
+}
+
+void ModbusTrafficStats::AddBusyTime( U64 starting_sample, U64 ending_sample )
+{
+    if( ending_sample < starting_sample )
+        return;
+
+    // out of room: merge neighbouring buckets, which halves the resolution and frees up the back half
+    while( ending_sample >= mBucketWidth * MODBUS_STATS_UTILIZATION_BUCKETS )
+    {
+        for( U32 i = 0; i < MODBUS_STATS_UTILIZATION_BUCKETS / 2; i++ )
+            mBusySamples[ i ] = mBusySamples[ 2 * i ] + mBusySamples[ 2 * i + 1 ];
+
+        memset( mBusySamples + MODBUS_STATS_UTILIZATION_BUCKETS / 2, 0, sizeof( mBusySamples ) / 2 );
+        mBucketWidth *= 2;
+    }
+
+    // an ADU can straddle bucket boundaries; each bucket gets the part that falls inside it
+    U64 sample = starting_sample;
+    while( sample <= ending_sample )
+    {
+        U32 bucket = U32( sample / mBucketWidth );
+        U64 bucket_end = ( bucket + 1 ) * mBucketWidth;
+        U64 span_end = ending_sample + 1 < bucket_end ? ending_sample + 1 : bucket_end;
+
+        mBusySamples[ bucket ] += span_end - sample;
+        sample = span_end;
+    }
+
+    if( ending_sample > mLastBusySample )
+        mLastBusySample = ending_sample;
+}
@@ -0,0 +1,67 @@
+#ifndef MODBUS_TRAFFIC_STATS
+#define MODBUS_TRAFFIC_STATS
+
+#include <LogicPublicTypes.h>
+#include "ModbusLatencyHistogram.h"
+
+// exception codes 0x01 to 0x0B are defined by the spec; anything else is counted in slot 0
+#define MODBUS_STATS_EXCEPTION_CODES 12
+
+// bus utilization is kept in this many time slices, however long the capture gets
+#define MODBUS_STATS_UTILIZATION_BUCKETS 256
+
+struct ModbusTrafficCounters
+{
+    U64 mAdus;
+    U64 mBytes;
+    U64 mRequests;
+    U64 mResponses;
+    U64 mExceptions[ MODBUS_STATS_EXCEPTION_CODES ];
+    U64 mChecksumErrors;
+    U64 mParityErrors;
+    U64 mFramingErrors;
+};
+
+// Running totals per device address and per function code, gathered while decoding so they never need a pass over the frames.
+// Memory use is fixed: the counters are indexed by the 8 bit address and code, and the utilization buckets double their width
+// (merging pairs) whenever the capture outgrows them.
+class ModbusTrafficStats
+{
+  public:
+    ModbusTrafficStats();
+
+    void Reset( U32 sample_rate_hz, U32 line_count );
+
+    // exception_code is only looked at when funccode has the exception bit set
+    void AddAdu( U8 devaddr, U8 funccode, bool response, U32 length, U8 exception_code, bool checksum_error, U32 parity_errors,
+                 U32 framing_errors, U64 starting_sample, U64 ending_sample );
+
+    // how long devaddr took to start answering a request
+    void AddResponseTime( U8 devaddr, U64 microseconds );
+
+    const ModbusTrafficCounters& GetDeviceCounters( U8 devaddr ) const;
+    const ModbusTrafficCounters& GetFunctionCounters( U8 funccode ) const; // exceptions are counted against their function
+    const ModbusTrafficCounters& GetTotals() const;
+    const ModbusLatencyHistogram& GetResponseTimes( U8 devaddr ) const;
+
+    U32 GetUtilizationBucketCount() const; // buckets up to the last busy one
+    U64 GetUtilizationBucketWidth() const; // in samples
+    double GetUtilization( U32 bucket ) const; // 0.0 to 1.0, averaged over the lines
+
+  protected:
+    void Count( ModbusTrafficCounters& counters, bool response, U32 length, S32 exception_slot, bool checksum_error, U32 parity_errors,
+                U32 framing_errors );
+    void AddBusyTime( U64 starting_sample, U64 ending_sample );
+
+    ModbusTrafficCounters mDevices[ 256 ];
+    ModbusTrafficCounters mFunctions[ 128 ];
+    ModbusTrafficCounters mTotals;
+    ModbusLatencyHistogram mResponseTimes[ 256 ];
+
+    U64 mBusySamples[ MODBUS_STATS_UTILIZATION_BUCKETS ];
+    U64 mBucketWidth;
+    U64 mLastBusySample;
+    U32 mLineCount;
+};
+
+#endif // MODBUS_TRAFFIC_STATS